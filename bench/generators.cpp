@@ -0,0 +1,138 @@
+/**
+ * Synthetic graphs for the benchmarks
+ *
+ * @author Bill Zhao
+ * @date updated on 10/17/2026
+ */
+
+#include "generators.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <random>
+
+using namespace std;
+
+namespace {
+
+const int EDGES_PER_VERTEX = 8;
+
+} // namespace
+
+vector<string> EdgeList::labels() const {
+  vector<string> Labels(Vertices);
+  for (int V = 0; V < Vertices; ++V)
+    Labels[V] = label(V);
+  return Labels;
+}
+
+bool EdgeList::writeFile(const string &Filename) const {
+  ofstream Output(Filename);
+  Output << Edges.size() << "\n";
+  for (auto &E : Edges)
+    Output << "V" << E.From << " V" << E.To << " " << E.Weight << "\n";
+  return static_cast<bool>(Output);
+}
+
+const char *familyName(GraphFamily Family) {
+  switch (Family) {
+  case GraphFamily::ErdosRenyi:
+    return "ErdosRenyi";
+  case GraphFamily::Rmat:
+    return "Rmat";
+  case GraphFamily::Grid:
+    return "Grid";
+  }
+  return "";
+}
+
+EdgeList generateEdges(GraphFamily Family, int64_t EdgeCount, unsigned Seed) {
+  int Vertices = static_cast<int>(max<int64_t>(2, EdgeCount / EDGES_PER_VERTEX));
+  switch (Family) {
+  case GraphFamily::ErdosRenyi:
+    return erdosRenyiEdges(Vertices, EdgeCount, Seed);
+  case GraphFamily::Rmat:
+    return rmatEdges(Vertices, EdgeCount, Seed);
+  case GraphFamily::Grid: {
+    // a side of S vertices has 2 * S * (S - 1) links, each one is two edges
+    int Side = max(2, static_cast<int>(lround(sqrt(EdgeCount / 4.0))));
+    return gridEdges(Side, Side, Seed);
+  }
+  }
+  return EdgeList();
+}
+
+// both ends uniform, redrawing the end of a loop
+EdgeList erdosRenyiEdges(int Vertices, int64_t EdgeCount, unsigned Seed) {
+  mt19937 Random(Seed);
+  uniform_int_distribution<int> PickVertex(0, Vertices - 1);
+  uniform_int_distribution<int> PickWeight(1, 100);
+  EdgeList List;
+  List.Vertices = Vertices;
+  List.Edges.reserve(EdgeCount);
+  for (int64_t I = 0; I < EdgeCount; ++I) {
+    int From = PickVertex(Random);
+    int To = PickVertex(Random);
+    while (To == From)
+      To = PickVertex(Random);
+    List.Edges.push_back({From, To, PickWeight(Random)});
+  }
+  return List;
+}
+
+// each bit of the two ends comes from one quadrant choice, from the highest
+// bit down, so vertices with small numbers get most of the edges
+EdgeList rmatEdges(int Vertices, int64_t EdgeCount, unsigned Seed, double A,
+                   double B, double C) {
+  int Bits = 1;
+  while ((1 << Bits) < Vertices)
+    ++Bits;
+  mt19937 Random(Seed);
+  uniform_real_distribution<double> Pick(0.0, 1.0);
+  uniform_int_distribution<int> PickWeight(1, 100);
+  EdgeList List;
+  List.Vertices = 1 << Bits;
+  List.Edges.reserve(EdgeCount);
+  while (List.Edges.size() < EdgeCount) {
+    int From = 0;
+    int To = 0;
+    for (int Bit = Bits - 1; Bit >= 0; --Bit) {
+      double P = Pick(Random);
+      if (P >= A + B + C) {
+        From |= 1 << Bit;
+        To |= 1 << Bit;
+      } else if (P >= A + B) {
+        From |= 1 << Bit;
+      } else if (P >= A) {
+        To |= 1 << Bit;
+      }
+    }
+    if (From != To)
+      List.Edges.push_back({From, To, PickWeight(Random)});
+  }
+  return List;
+}
+
+// vertex R * Columns + C is linked both ways to its right and lower neighbor
+EdgeList gridEdges(int Rows, int Columns, unsigned Seed) {
+  mt19937 Random(Seed);
+  uniform_int_distribution<int> PickWeight(1, 100);
+  EdgeList List;
+  List.Vertices = Rows * Columns;
+  List.Edges.reserve(4 * static_cast<size_t>(Rows) * Columns);
+  auto Link = [&](int From, int To) {
+    int Weight = PickWeight(Random);
+    List.Edges.push_back({From, To, Weight});
+    List.Edges.push_back({To, From, Weight});
+  };
+  for (int R = 0; R < Rows; ++R) {
+    for (int C = 0; C < Columns; ++C) {
+      int V = R * Columns + C;
+      if (C + 1 < Columns)
+        Link(V, V + 1);
+      if (R + 1 < Rows)
+        Link(V, V + Columns);
+    }
+  }
+  return List;
+}
@@ -0,0 +1,64 @@
+/**
+ * Synthetic graphs for the benchmarks
+ * Erdos-Renyi picks both ends of every edge uniformly, R-MAT picks them by
+ * recursively splitting the adjacency matrix into unequal quadrants, which
+ * gives a few very high degree vertices like social and web graphs, and
+ * Grid is a road-like lattice where every vertex has at most four neighbors
+ * The same family, size and seed always give the same edges
+ *
+ * @author Bill Zhao
+ * @date updated on 10/17/2026
+ */
+
+#ifndef GENERATORS_H
+#define GENERATORS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+enum class GraphFamily { ErdosRenyi, Rmat, Grid };
+
+// edge between vertex numbers, labels are made by EdgeList::label
+struct GeneratedEdge {
+  int From;
+  int To;
+  int Weight;
+};
+
+struct EdgeList {
+  int Vertices = 0;
+  vector<GeneratedEdge> Edges;
+
+  // @return label of vertex number V, "V" followed by the number
+  static string label(int V) { return "V" + to_string(V); }
+
+  // labels of all vertices, so loops over the edges do not build strings
+  vector<string> labels() const;
+
+  // write in the graph*.txt format
+  // @return false if the file could not be written
+  bool writeFile(const string &Filename) const;
+};
+
+// @return name of the family, used in benchmark names
+const char *familyName(GraphFamily Family);
+
+// @return about EdgeCount edges of the given family, weights are 1 to 100
+// Erdos-Renyi and R-MAT have 8 edges per vertex on average, Grid is the
+// square lattice with edges both ways that is closest to EdgeCount
+EdgeList generateEdges(GraphFamily Family, int64_t EdgeCount,
+                       unsigned Seed = 1);
+
+EdgeList erdosRenyiEdges(int Vertices, int64_t EdgeCount, unsigned Seed);
+
+// quadrant probabilities A, B, C and 1 - A - B - C, Vertices is rounded up
+// to a power of two
+EdgeList rmatEdges(int Vertices, int64_t EdgeCount, unsigned Seed,
+                   double A = 0.57, double B = 0.19, double C = 0.19);
+
+EdgeList gridEdges(int Rows, int Columns, unsigned Seed);
+
+#endif // GENERATORS_H
@@ -0,0 +1,604 @@
+/**
+ * Benchmarks for the graph class
+ * Uses google benchmark, built as the graph_bench target when available
+ *
+ * @author Bill Zhao
+ * @date updated on 10/17/2026
+ */
+
+#include "../graph.h"
+#include "../concurrentbuilder.h"
+#include "../dynamicpaths.h"
+#include "../pathqueries.h"
+#include "../versionedgraph.h"
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+using namespace std;
+
+// write a random edge list in the graph*.txt format
+// every vertex gets EdgesPerVertex outgoing edges to random vertices
+static void writeRandomGraph(const string &Filename, int VertexCount,
+                             int EdgesPerVertex) {
+  mt19937 Random(VertexCount);
+  uniform_int_distribution<int> PickVertex(0, VertexCount - 1);
+  uniform_int_distribution<int> PickWeight(1, 100);
+  ofstream Output(Filename);
+  Output << VertexCount * EdgesPerVertex << "\n";
+  for (int I = 0; I < VertexCount; ++I) {
+    for (int J = 0; J < EdgesPerVertex; ++J) {
+      Output << "V" << I << " V" << PickVertex(Random) << " "
+             << PickWeight(Random) << "\n";
+    }
+  }
+}
+
+// fill the graph with a random edge list, read through a temporary file
+static void loadRandomGraph(Graph &G, int VertexCount, int EdgesPerVertex) {
+  const string Filename = "bench-graph.txt";
+  writeRandomGraph(Filename, VertexCount, EdgesPerVertex);
+  G.readFile(Filename);
+  remove(Filename.c_str());
+}
+
+// time to load an edge list from file as the number of vertices grows
+static void bmReadFile(benchmark::State &State) {
+  const int VertexCount = static_cast<int>(State.range(0));
+  const int EdgesPerVertex = 4;
+  const string Filename = "bench-readfile.txt";
+  writeRandomGraph(Filename, VertexCount, EdgesPerVertex);
+  for (auto _ : State) {
+    Graph G;
+    benchmark::DoNotOptimize(G.readFile(Filename));
+  }
+  remove(Filename.c_str());
+  State.SetItemsProcessed(State.iterations() * VertexCount * EdgesPerVertex);
+  State.counters["vertices"] = VertexCount;
+}
+BENCHMARK(bmReadFile)
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 18)
+    ->Unit(benchmark::kMillisecond);
+
+// time to load the same edge list with the parallel reader
+// only measured on a single core so far, where the threads just add
+// overhead, the speedup on several cores is still unverified
+static void bmReadFileParallel(benchmark::State &State) {
+  const int VertexCount = static_cast<int>(State.range(0));
+  const int Threads = static_cast<int>(State.range(1));
+  const int EdgesPerVertex = 4;
+  const string Filename = "bench-readfile.txt";
+  writeRandomGraph(Filename, VertexCount, EdgesPerVertex);
+  for (auto _ : State) {
+    Graph G;
+    benchmark::DoNotOptimize(G.readFileParallel(Filename, Threads));
+  }
+  remove(Filename.c_str());
+  State.SetItemsProcessed(State.iterations() * VertexCount * EdgesPerVertex);
+  State.counters["vertices"] = VertexCount;
+}
+BENCHMARK(bmReadFileParallel)
+    ->ArgsProduct({{1 << 14, 1 << 18}, {1, 4, 16}})
+    ->Unit(benchmark::kMillisecond);
+
+// time to map a binary snapshot of the same graphs as bmReadFile
+static void bmMapFile(benchmark::State &State) {
+  const int VertexCount = static_cast<int>(State.range(0));
+  const string Filename = "bench-mapfile.bin";
+  Graph G;
+  loadRandomGraph(G, VertexCount, 4);
+  G.freeze().writeFile(Filename);
+  for (auto _ : State) {
+    CsrGraph Csr;
+    benchmark::DoNotOptimize(Csr.mapFile(Filename));
+  }
+  remove(Filename.c_str());
+  State.SetItemsProcessed(State.iterations() * G.edgesSize());
+}
+BENCHMARK(bmMapFile)
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 18)
+    ->Unit(benchmark::kMillisecond);
+
+// visitor that does nothing, so only the traversal is timed
+static void ignoreLabel(const string & /*Label*/) {}
+// visitor for id traversals that does nothing
+static void ignoreId(VertexId /*Id*/) {}
+
+// bfs over the pointer based graph
+static void bmBfsGraph(benchmark::State &State) {
+  const int VertexCount = static_cast<int>(State.range(0));
+  Graph G;
+  loadRandomGraph(G, VertexCount, 4);
+  for (auto _ : State)
+    G.bfs("V0", ignoreLabel);
+  State.SetItemsProcessed(State.iterations() * G.edgesSize());
+}
+BENCHMARK(bmBfsGraph)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 16)
+    ->Unit(benchmark::kMillisecond);
+
+// bfs over the compressed snapshot of the same graph
+static void bmBfsCsr(benchmark::State &State) {
+  const int VertexCount = static_cast<int>(State.range(0));
+  Graph G;
+  loadRandomGraph(G, VertexCount, 4);
+  CsrGraph Csr = G.freeze();
+  for (auto _ : State)
+    Csr.bfs("V0", ignoreLabel);
+  State.SetItemsProcessed(State.iterations() * Csr.edgesSize());
+}
+BENCHMARK(bmBfsCsr)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 16)
+    ->Unit(benchmark::kMillisecond);
+
+// finding the 100th vertex, 0 walks the whole graph with a function
+// pointer, 1 stops the visitor there and 2 breaks out of a bfs range
+static void bmBfsFirstHundred(benchmark::State &State) {
+  Graph G;
+  loadRandomGraph(G, 1 << 16, 4);
+  const VertexId Start = G.idOf("V0");
+  for (auto _ : State) {
+    int Seen = 0;
+    if (State.range(0) == 0) {
+      G.bfs(Start, ignoreId);
+    } else if (State.range(0) == 1) {
+      G.bfs(Start, [&Seen](VertexId /*Id*/) {
+        return ++Seen == 100 ? VisitResult::Stop : VisitResult::Continue;
+      });
+    } else {
+      for (VertexId Id : G.bfsRange(Start)) {
+        benchmark::DoNotOptimize(Id);
+        if (++Seen == 100)
+          break;
+      }
+    }
+    benchmark::DoNotOptimize(Seen);
+  }
+}
+BENCHMARK(bmBfsFirstHundred)
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(2)
+    ->Unit(benchmark::kMicrosecond);
+
+// single source shortest paths on the graph, dense result
+static void bmDijkstra(benchmark::State &State) {
+  const int VertexCount = static_cast<int>(State.range(0));
+  Graph G;
+  loadRandomGraph(G, VertexCount, 8);
+  for (auto _ : State)
+    benchmark::DoNotOptimize(G.dijkstra(G.idOf("V0")));
+  State.SetItemsProcessed(State.iterations() * G.edgesSize());
+}
+BENCHMARK(bmDijkstra)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 17)
+    ->Unit(benchmark::kMillisecond);
+
+// direction-optimizing bfs on the snapshot, second argument is the threads
+static void bmParallelBfs(benchmark::State &State) {
+  Graph G;
+  loadRandomGraph(G, static_cast<int>(State.range(0)), 8);
+  CsrGraph Csr = G.freeze();
+  const int Threads = static_cast<int>(State.range(1));
+  for (auto _ : State)
+    benchmark::DoNotOptimize(Csr.parallelBfs(0, Threads));
+  State.SetItemsProcessed(State.iterations() * Csr.edgesSize());
+  State.counters["threads"] = Threads;
+}
+BENCHMARK(bmParallelBfs)
+    ->ArgsProduct({{1 << 17}, {1, 2, 4, 8, 16}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// sequential dijkstra on the snapshot, baseline for delta-stepping
+static void bmDijkstraCsr(benchmark::State &State) {
+  Graph G;
+  loadRandomGraph(G, static_cast<int>(State.range(0)), 8);
+  CsrGraph Csr = G.freeze();
+  for (auto _ : State)
+    benchmark::DoNotOptimize(Csr.dijkstra(0));
+  State.SetItemsProcessed(State.iterations() * Csr.edgesSize());
+}
+BENCHMARK(bmDijkstraCsr)->Arg(1 << 17)->Unit(benchmark::kMillisecond);
+
+// shortest paths on a snapshot with weights of type W, compare with
+// bmDijkstraCsr, Unweighted is a bfs
+template <typename W> static void bmWeightedPaths(benchmark::State &State) {
+  Graph G;
+  loadRandomGraph(G, static_cast<int>(State.range(0)), 8);
+  WeightedCsr<W> Snapshot = G.freezeAs<W>();
+  for (auto _ : State)
+    benchmark::DoNotOptimize(Snapshot.shortestPaths(0));
+  State.SetItemsProcessed(State.iterations() * Snapshot.edgesSize());
+  State.counters["bytes"] = static_cast<double>(Snapshot.memoryBytes());
+}
+BENCHMARK_TEMPLATE(bmWeightedPaths, uint8_t)
+    ->Arg(1 << 17)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(bmWeightedPaths, int32_t)
+    ->Arg(1 << 17)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(bmWeightedPaths, double)
+    ->Arg(1 << 17)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(bmWeightedPaths, Unweighted)
+    ->Arg(1 << 17)
+    ->Unit(benchmark::kMillisecond);
+
+// delta-stepping on the snapshot, second argument is the thread count
+static void bmDeltaStepping(benchmark::State &State) {
+  Graph G;
+  loadRandomGraph(G, static_cast<int>(State.range(0)), 8);
+  CsrGraph Csr = G.freeze();
+  const int Threads = static_cast<int>(State.range(1));
+  for (auto _ : State)
+    benchmark::DoNotOptimize(Csr.deltaStepping(0, 0, Threads));
+  State.SetItemsProcessed(State.iterations() * Csr.edgesSize());
+  State.counters["threads"] = Threads;
+}
+BENCHMARK(bmDeltaStepping)
+    ->ArgsProduct({{1 << 17}, {1, 2, 4, 8, 16}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// build and tear down a random graph, reporting its bytes per edge
+static void bmBuildAndDestroy(benchmark::State &State) {
+  const int VertexCount = static_cast<int>(State.range(0));
+  const int EdgesPerVertex = 4;
+  mt19937 Random(VertexCount);
+  uniform_int_distribution<int> PickVertex(0, VertexCount - 1);
+  vector<tuple<string, string, int>> NewEdges;
+  for (int I = 0; I < VertexCount; ++I) {
+    for (int J = 0; J < EdgesPerVertex; ++J)
+      NewEdges.emplace_back("V" + to_string(I),
+                            "V" + to_string(PickVertex(Random)), J + 1);
+  }
+  GraphMemory Memory;
+  int Edges = 0;
+  for (auto _ : State) {
+    Graph G;
+    G.addEdges(NewEdges);
+    Memory = G.memoryUsage();
+    Edges = G.edgesSize();
+  }
+  State.SetItemsProcessed(State.iterations() * NewEdges.size());
+  State.counters["bytes_per_edge"] =
+      static_cast<double>(Memory.total()) / max(Edges, 1);
+}
+BENCHMARK(bmBuildAndDestroy)
+    ->RangeMultiplier(8)
+    ->Range(1 << 12, 1 << 18)
+    ->Unit(benchmark::kMillisecond);
+
+// random pairs of vertices on a random undirected graph, the second
+// argument is 1 to use shortestPath and 0 to run dijkstra from the source
+// and walk the previous vertices back from the target
+static void bmShortestPath(benchmark::State &State) {
+  const int VertexCount = static_cast<int>(State.range(0));
+  const bool PointToPoint = State.range(1) != 0;
+  Graph G(false);
+  loadRandomGraph(G, VertexCount, 4);
+  mt19937 Random(7);
+  uniform_int_distribution<int> PickVertex(0, G.verticesSize() - 1);
+  vector<VertexId> Path;
+  for (auto _ : State) {
+    VertexId From = PickVertex(Random);
+    VertexId To = PickVertex(Random);
+    if (PointToPoint) {
+      benchmark::DoNotOptimize(G.shortestPath(From, To, Path));
+    } else {
+      vector<VertexId> Prev = G.dijkstra(From).second;
+      Path.clear();
+      for (VertexId V = To; V != NO_VERTEX; V = Prev[V])
+        Path.push_back(V);
+      benchmark::DoNotOptimize(Path.data());
+    }
+  }
+}
+BENCHMARK(bmShortestPath)
+    ->ArgsProduct({{1 << 12, 1 << 16, 1 << 18}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+// random pairs on a random directed graph, the argument is 1 to search from
+// both ends with the in-edge index and 0 to search from the source only
+static void bmShortestPathDirected(benchmark::State &State) {
+  Graph G;
+  if (State.range(0) != 0)
+    G.indexInEdges();
+  loadRandomGraph(G, 1 << 16, 4);
+  mt19937 Random(7);
+  uniform_int_distribution<int> PickVertex(0, G.verticesSize() - 1);
+  vector<VertexId> Path;
+  for (auto _ : State)
+    benchmark::DoNotOptimize(
+        G.shortestPath(PickVertex(Random), PickVertex(Random), Path));
+}
+BENCHMARK(bmShortestPathDirected)
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMicrosecond);
+
+// edges into random vertices, the argument is 1 with the in-edge index
+// and 0 without it
+static void bmInEdges(benchmark::State &State) {
+  Graph G;
+  if (State.range(0) != 0)
+    G.indexInEdges();
+  loadRandomGraph(G, 1 << 16, 4);
+  mt19937 Random(11);
+  uniform_int_distribution<int> PickVertex(0, G.verticesSize() - 1);
+  for (auto _ : State)
+    benchmark::DoNotOptimize(G.inNeighborsSize(G.labelOf(PickVertex(Random))));
+}
+BENCHMARK(bmInEdges)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+// the same batch of hub sources asked again and again, the argument is the
+// cache capacity, 0 computes every source every time
+static void bmPathQueries(benchmark::State &State) {
+  const int Capacity = static_cast<int>(State.range(0));
+  Graph G;
+  loadRandomGraph(G, 1 << 12, 4);
+  vector<string> Hubs;
+  for (VertexId V = 0; V < 64; ++V)
+    Hubs.push_back(G.labelOf(V));
+  PathQueries Queries(G, Capacity);
+  Queries.dijkstra(Hubs);
+  for (auto _ : State)
+    benchmark::DoNotOptimize(Queries.dijkstra(Hubs));
+  State.SetItemsProcessed(State.iterations() * Hubs.size());
+}
+BENCHMARK(bmPathQueries)->Arg(0)->Arg(64)->Unit(benchmark::kMicrosecond);
+
+// ignore the edges of the minimum spanning tree
+static void ignoreEdge(const string & /*From*/, const string & /*To*/,
+                       int /*Weight*/) {}
+
+// each mst algorithm on one random undirected graph, the second argument
+// is the algorithm, the third the number of threads used by boruvka
+static void bmMst(benchmark::State &State) {
+  const int VertexCount = static_cast<int>(State.range(0));
+  const auto Algorithm = static_cast<MstAlgorithm>(State.range(1));
+  const int Threads = static_cast<int>(State.range(2));
+  Graph G(false);
+  loadRandomGraph(G, VertexCount, 4);
+  const string Start = G.labelOf(0);
+  for (auto _ : State)
+    benchmark::DoNotOptimize(G.mst(Start, ignoreEdge, Algorithm, Threads));
+  State.SetItemsProcessed(State.iterations() * G.edgesSize());
+}
+BENCHMARK(bmMst)
+    ->Args({1 << 16, static_cast<int>(MstAlgorithm::Prim), 1})
+    ->Args({1 << 16, static_cast<int>(MstAlgorithm::Kruskal), 1})
+    ->Args({1 << 16, static_cast<int>(MstAlgorithm::Boruvka), 1})
+    ->Args({1 << 16, static_cast<int>(MstAlgorithm::Boruvka), 4})
+    ->Args({1 << 16, static_cast<int>(MstAlgorithm::Boruvka), 16})
+    ->Unit(benchmark::kMillisecond);
+
+// random reweights of a random graph with a few tracked sources, the
+// argument is 1 to repair the paths with DynamicPaths and 0 to run
+// dijkstra again from every source after each change
+static void bmDynamicPaths(benchmark::State &State) {
+  const bool Repair = State.range(0) != 0;
+  Graph G;
+  loadRandomGraph(G, 1 << 16, 4);
+  DynamicPaths Dynamic(G);
+  vector<string> Sources;
+  for (VertexId V = 0; V < 4; ++V) {
+    Sources.push_back(G.labelOf(V));
+    Dynamic.track(Sources.back());
+  }
+  mt19937 Random(5);
+  uniform_int_distribution<int> PickVertex(0, G.verticesSize() - 1);
+  uniform_int_distribution<int> PickWeight(1, 100);
+  for (auto _ : State) {
+    const string &From = G.labelOf(PickVertex(Random));
+    const string &To = G.labelOf(PickVertex(Random));
+    int Weight = PickWeight(Random);
+    if (Repair) {
+      if (!Dynamic.setWeight(From, To, Weight))
+        Dynamic.connect(From, To, Weight);
+      benchmark::DoNotOptimize(Dynamic.paths(Sources[0]));
+    } else {
+      if (!G.setWeight(From, To, Weight))
+        G.connect(From, To, Weight);
+      for (auto &Source : Sources)
+        benchmark::DoNotOptimize(G.dijkstra(G.idOf(Source)));
+    }
+  }
+}
+BENCHMARK(bmDynamicPaths)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+// strongly connected components of a sparse random graph, the first
+// argument is the algorithm, the second the threads of ForwardBackward
+static void bmStronglyConnected(benchmark::State &State) {
+  const auto Algorithm = static_cast<SccAlgorithm>(State.range(0));
+  const int Threads = static_cast<int>(State.range(1));
+  Graph G;
+  loadRandomGraph(G, 1 << 18, 2);
+  for (auto _ : State)
+    benchmark::DoNotOptimize(G.stronglyConnected(Algorithm, Threads));
+  State.SetItemsProcessed(State.iterations() * G.edgesSize());
+}
+BENCHMARK(bmStronglyConnected)
+    ->Args({static_cast<int>(SccAlgorithm::Tarjan), 1})
+    ->Args({static_cast<int>(SccAlgorithm::Kosaraju), 1})
+    ->Args({static_cast<int>(SccAlgorithm::ForwardBackward), 1})
+    ->Args({static_cast<int>(SccAlgorithm::ForwardBackward), 4})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// bfs on the latest version of a graph while a writer publishes a new
+// version after every edge, argument 1 runs the writer, 0 leaves it idle
+static void bmVersionedReads(benchmark::State &State) {
+  const int VertexCount = 1 << 14;
+  mt19937 Random(VertexCount);
+  uniform_int_distribution<int> PickVertex(0, VertexCount - 1);
+  VersionedGraph Versions;
+  for (int I = 0; I < VertexCount * 4; ++I)
+    Versions.connect("V" + to_string(I / 4), "V" + to_string(PickVertex(Random)),
+                     1);
+  Versions.publish();
+  atomic<bool> Done(false);
+  thread Writer([&]() {
+    while (State.range(0) == 1 && !Done) {
+      Versions.connect("V" + to_string(PickVertex(Random)),
+                       "V" + to_string(PickVertex(Random)), 1);
+      Versions.publish();
+    }
+  });
+  for (auto _ : State) {
+    auto Snapshot = Versions.snapshot();
+    int Reached = 0;
+    Snapshot->bfs(0, [&Reached](VertexId /*Id*/) { Reached++; });
+    benchmark::DoNotOptimize(Reached);
+  }
+  Done = true;
+  Writer.join();
+}
+BENCHMARK(bmVersionedReads)
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+// one version made of 64 new vertices and one new edge, on graphs of
+// growing size, a version should cost the same whatever the size
+static void bmVersionedPublish(benchmark::State &State) {
+  const int VertexCount = static_cast<int>(State.range(0));
+  VersionedGraph Versions;
+  for (int I = 0; I < VertexCount; ++I)
+    Versions.add("V" + to_string(I));
+  Versions.publish();
+  int Next = VertexCount;
+  for (auto _ : State) {
+    for (int I = 0; I < 64; ++I)
+      Versions.add("V" + to_string(Next++));
+    Versions.connect("V" + to_string(Next - 2), "V" + to_string(Next - 1),
+                     1);
+    benchmark::DoNotOptimize(Versions.publish());
+  }
+  State.counters["vertices"] = VertexCount;
+}
+BENCHMARK(bmVersionedPublish)
+    ->RangeMultiplier(8)
+    ->Range(1 << 14, 1 << 20)
+    ->Unit(benchmark::kMicrosecond);
+
+// star graph where one vertex has all the edges, added one edge at a time
+static vector<tuple<string, string, int>> starEdges(int EdgeCount) {
+  vector<tuple<string, string, int>> Star;
+  for (int I = 0; I < EdgeCount; ++I)
+    Star.emplace_back("Hub", "V" + to_string(I), I % 100);
+  return Star;
+}
+
+// connect each edge of a high degree star
+static void bmConnectStar(benchmark::State &State) {
+  auto Star = starEdges(static_cast<int>(State.range(0)));
+  for (auto _ : State) {
+    Graph G;
+    for (auto &E : Star)
+      G.connect(get<0>(E), get<1>(E), get<2>(E));
+    benchmark::DoNotOptimize(G.edgesSize());
+  }
+  State.SetItemsProcessed(State.iterations() * Star.size());
+}
+BENCHMARK(bmConnectStar)
+    ->RangeMultiplier(4)
+    ->Range(1 << 8, 1 << 14)
+    ->Unit(benchmark::kMillisecond);
+
+// add all edges of a high degree star at once
+static void bmAddEdgesStar(benchmark::State &State) {
+  auto Star = starEdges(static_cast<int>(State.range(0)));
+  for (auto _ : State) {
+    Graph G;
+    benchmark::DoNotOptimize(G.addEdges(Star));
+  }
+  State.SetItemsProcessed(State.iterations() * Star.size());
+}
+BENCHMARK(bmAddEdgesStar)
+    ->RangeMultiplier(4)
+    ->Range(1 << 8, 1 << 14)
+    ->Unit(benchmark::kMillisecond);
+
+// random edges added by several threads through the builder, argument is
+// the threads, 0 adds them all with addEdges on one thread instead
+static void bmConcurrentBuild(benchmark::State &State) {
+  const int Threads = static_cast<int>(State.range(0));
+  const int VertexCount = 1 << 15;
+  mt19937 Random(VertexCount);
+  uniform_int_distribution<int> PickVertex(0, VertexCount - 1);
+  vector<tuple<string, string, int>> Edges;
+  for (int I = 0; I < VertexCount * 8; ++I)
+    Edges.emplace_back("V" + to_string(I / 8),
+                       "V" + to_string(PickVertex(Random)), 1);
+  for (auto _ : State) {
+    Graph G;
+    if (Threads == 0) {
+      G.addEdges(Edges);
+      continue;
+    }
+    ConcurrentGraphBuilder Builder;
+    vector<thread> Workers;
+    for (int T = 0; T < Threads; ++T) {
+      Workers.emplace_back([&Edges, &Builder, Threads, T]() {
+        for (size_t I = T; I < Edges.size(); I += Threads)
+          Builder.connect(get<0>(Edges[I]), get<1>(Edges[I]), get<2>(Edges[I]));
+      });
+    }
+    for (auto &Worker : Workers)
+      Worker.join();
+    Builder.addTo(G, Threads);
+  }
+  State.SetItemsProcessed(State.iterations() * Edges.size());
+}
+BENCHMARK(bmConcurrentBuild)
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// all pairs on 1024 vertices, first argument is the engine, 0 for dijkstra
+// from every vertex, second the edges per vertex
+static void bmAllPairs(benchmark::State &State) {
+  const int Engine = static_cast<int>(State.range(0));
+  Graph G;
+  loadRandomGraph(G, 1 << 10, static_cast<int>(State.range(1)));
+  for (auto _ : State) {
+    if (Engine == 0) {
+      for (VertexId V = 0; V < G.verticesSize(); ++V)
+        benchmark::DoNotOptimize(G.dijkstra(V));
+      continue;
+    }
+    DistanceMatrix Paths;
+    G.allPairs(Paths, static_cast<ApspAlgorithm>(Engine));
+    benchmark::DoNotOptimize(Paths.Dist.data());
+  }
+  State.SetItemsProcessed(State.iterations() * G.verticesSize() *
+                          G.verticesSize());
+}
+BENCHMARK(bmAllPairs)
+    ->Args({0, 8})
+    ->Args({static_cast<int>(ApspAlgorithm::FloydWarshall), 8})
+    ->Args({static_cast<int>(ApspAlgorithm::Johnson), 8})
+    ->Args({0, 128})
+    ->Args({static_cast<int>(ApspAlgorithm::FloydWarshall), 128})
+    ->Args({static_cast<int>(ApspAlgorithm::Johnson), 128})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,189 @@
+/**
+ * Benchmark suite over the generated graph families
+ * Every operation runs on Erdos-Renyi, R-MAT and Grid graphs from 1K to
+ * 10M edges, the first argument is the family and the second the edges
+ * Each reports edges per second as items_per_second and the peak resident
+ * memory during the timed loop as peak_bytes, use
+ * --benchmark_filter=Suite --benchmark_out=results.json
+ * --benchmark_out_format=json to keep the results
+ *
+ * @author Bill Zhao
+ * @date updated on 10/17/2026
+ */
+
+#include "../graph.h"
+#include "generators.h"
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+#include <sys/resource.h>
+
+using namespace std;
+
+namespace {
+
+// start the peak resident memory again from the current one, after giving
+// freed memory back so earlier benchmarks do not count
+// linux only, elsewhere the peak is for the whole run
+void resetPeakMemory() {
+#ifdef __GLIBC__
+  malloc_trim(0);
+#endif
+  ofstream ClearRefs("/proc/self/clear_refs");
+  ClearRefs << "5";
+}
+
+// @return peak resident memory in bytes since resetPeakMemory
+int64_t peakMemory() {
+  ifstream Status("/proc/self/status");
+  string Key;
+  while (Status >> Key) {
+    if (Key == "VmHWM:") {
+      int64_t KiloBytes = 0;
+      Status >> KiloBytes;
+      return KiloBytes * 1024;
+    }
+  }
+  struct rusage Usage = {};
+  getrusage(RUSAGE_SELF, &Usage);
+  return static_cast<int64_t>(Usage.ru_maxrss) * 1024;
+}
+
+// graph of the family and size given by the arguments of the benchmark
+EdgeList generated(benchmark::State &State) {
+  auto Family = static_cast<GraphFamily>(State.range(0));
+  State.SetLabel(familyName(Family));
+  return generateEdges(Family, State.range(1));
+}
+
+// load through a temporary file with the parallel reader
+void load(Graph &G, const EdgeList &List) {
+  const string Filename = "bench-suite.txt";
+  List.writeFile(Filename);
+  G.readFileParallel(Filename);
+  remove(Filename.c_str());
+}
+
+// size of a graph, kept after the graph is gone
+struct GraphSize {
+  int Vertices = 0;
+  int Edges = 0;
+  size_t Bytes = 0;
+};
+
+GraphSize sizeOf(const Graph &G) {
+  return {G.verticesSize(), G.edgesSize(), G.memoryUsage().total()};
+}
+
+// counters shared by the suite, Edges is the work done per iteration
+void report(benchmark::State &State, int64_t Edges, const GraphSize &Size) {
+  State.SetItemsProcessed(State.iterations() * Edges);
+  State.counters["peak_bytes"] = static_cast<double>(peakMemory());
+  State.counters["graph_bytes"] = static_cast<double>(Size.Bytes);
+  State.counters["vertices"] = Size.Vertices;
+  State.counters["edges"] = Size.Edges;
+}
+
+void ignoreLabel(const string & /*Label*/) {}
+
+void ignoreEdge(const string & /*From*/, const string & /*To*/,
+                int /*Weight*/) {}
+
+// every family at every size
+void suiteSizes(benchmark::internal::Benchmark *B) {
+  for (auto Family :
+       {GraphFamily::ErdosRenyi, GraphFamily::Rmat, GraphFamily::Grid}) {
+    for (int64_t Edges = 1000; Edges <= 10000000; Edges *= 10)
+      B->Args({static_cast<int64_t>(Family), Edges});
+  }
+}
+
+} // namespace
+
+// load the edge list from a file with readFile, the graph is destroyed
+// in the timed loop as well
+static void bmSuiteReadFile(benchmark::State &State) {
+  EdgeList List = generated(State);
+  const string Filename = "bench-suite-readfile.txt";
+  List.writeFile(Filename);
+  resetPeakMemory();
+  GraphSize Size;
+  for (auto _ : State) {
+    Graph G;
+    benchmark::DoNotOptimize(G.readFile(Filename));
+    State.PauseTiming();
+    Size = sizeOf(G);
+    State.ResumeTiming();
+  }
+  remove(Filename.c_str());
+  report(State, List.Edges.size(), Size);
+}
+
+// build the graph one connect at a time
+static void bmSuiteConnect(benchmark::State &State) {
+  EdgeList List = generated(State);
+  vector<string> Labels = List.labels();
+  resetPeakMemory();
+  GraphSize Size;
+  for (auto _ : State) {
+    Graph G;
+    for (auto &E : List.Edges)
+      G.connect(Labels[E.From], Labels[E.To], E.Weight);
+    State.PauseTiming();
+    Size = sizeOf(G);
+    State.ResumeTiming();
+  }
+  report(State, List.Edges.size(), Size);
+}
+
+// bfs from vertex V0, counted as every edge of the graph
+static void bmSuiteBfs(benchmark::State &State) {
+  Graph G;
+  load(G, generated(State));
+  resetPeakMemory();
+  for (auto _ : State)
+    G.bfs("V0", ignoreLabel);
+  report(State, G.edgesSize(), sizeOf(G));
+}
+
+// dfs from vertex V0
+static void bmSuiteDfs(benchmark::State &State) {
+  Graph G;
+  load(G, generated(State));
+  resetPeakMemory();
+  for (auto _ : State)
+    G.dfs("V0", ignoreLabel);
+  report(State, G.edgesSize(), sizeOf(G));
+}
+
+// all shortest paths from vertex V0
+static void bmSuiteDijkstra(benchmark::State &State) {
+  Graph G;
+  load(G, generated(State));
+  const VertexId Source = G.idOf("V0");
+  resetPeakMemory();
+  for (auto _ : State)
+    benchmark::DoNotOptimize(G.dijkstra(Source));
+  report(State, G.edgesSize(), sizeOf(G));
+}
+
+// prim on the same edges read as an undirected graph
+static void bmSuiteMst(benchmark::State &State) {
+  Graph G(false);
+  load(G, generated(State));
+  resetPeakMemory();
+  for (auto _ : State)
+    benchmark::DoNotOptimize(G.mst("V0", ignoreEdge));
+  report(State, G.edgesSize(), sizeOf(G));
+}
+
+BENCHMARK(bmSuiteReadFile)->Apply(suiteSizes)->Unit(benchmark::kMillisecond);
+BENCHMARK(bmSuiteConnect)->Apply(suiteSizes)->Unit(benchmark::kMillisecond);
+BENCHMARK(bmSuiteBfs)->Apply(suiteSizes)->Unit(benchmark::kMillisecond);
+BENCHMARK(bmSuiteDfs)->Apply(suiteSizes)->Unit(benchmark::kMillisecond);
+BENCHMARK(bmSuiteDijkstra)->Apply(suiteSizes)->Unit(benchmark::kMillisecond);
+BENCHMARK(bmSuiteMst)->Apply(suiteSizes)->Unit(benchmark::kMillisecond);
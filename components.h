@@ -0,0 +1,92 @@
+/**
+ * Strongly connected components of a graph or of its snapshot
+ * Two vertices are in the same component when each can reach the other,
+ * in undirected graphs these are the connected components
+ * tarjanComponents is shared by Graph and CsrGraph, it works on any
+ * adjacency given as a degree and a target function
+ *
+ * @author Bill Zhao
+ * @date updated on 10/17/2026
+ */
+
+#ifndef COMPONENTS_H
+#define COMPONENTS_H
+
+#include "vertex.h"
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// component number of every vertex, indexed by id, from 0 to Count - 1
+struct Components {
+  vector<int> Component;
+  int Count = 0;
+};
+
+// how Graph::stronglyConnected finds the components
+enum class SccAlgorithm { Tarjan, Kosaraju, ForwardBackward };
+
+// iterative tarjan over the vertices 0..Size-1 for which Active is true,
+// edges to vertices that are not active are ignored
+// Degree(V) is the number of edges of V and Target(V, I) the end of edge I
+// sets Component for the active vertices, numbered from First, a component
+// is numbered before any component that has an edge into it
+// @return number of components found
+template <typename DegreeOf, typename TargetOf, typename IsActive>
+int tarjanComponents(int Size, DegreeOf Degree, TargetOf Target,
+                     IsActive Active, vector<int> &Component, int First) {
+  vector<int> Index(Size, -1);
+  vector<int> Low(Size);
+  vector<char> OnStack(Size, 0);
+  // vertices whose component is not known yet
+  vector<VertexId> Stack;
+  // the dfs, each entry is a vertex and the index of its next edge
+  vector<pair<VertexId, int>> Calls;
+  int Time = 0;
+  int Next = First;
+  auto Discover = [&](VertexId V) {
+    Index[V] = Low[V] = Time++;
+    Stack.push_back(V);
+    OnStack[V] = 1;
+    Calls.emplace_back(V, 0);
+  };
+  for (VertexId Root = 0; Root < Size; ++Root) {
+    if (!Active(Root) || Index[Root] != -1)
+      continue;
+    Discover(Root);
+    while (!Calls.empty()) {
+      VertexId V = Calls.back().first;
+      int I = Calls.back().second;
+      if (I < Degree(V)) {
+        Calls.back().second++;
+        VertexId W = Target(V, I);
+        if (!Active(W))
+          continue;
+        if (Index[W] == -1)
+          Discover(W);
+        else if (OnStack[W])
+          Low[V] = min(Low[V], Index[W]);
+        continue;
+      }
+      Calls.pop_back();
+      if (!Calls.empty())
+        Low[Calls.back().first] = min(Low[Calls.back().first], Low[V]);
+      if (Low[V] != Index[V])
+        continue;
+      // V is the first vertex of its component reached
+      VertexId W = NO_VERTEX;
+      do {
+        W = Stack.back();
+        Stack.pop_back();
+        OnStack[W] = 0;
+        Component[W] = Next;
+      } while (W != V);
+      Next++;
+    }
+  }
+  return Next - First;
+}
+
+#endif // COMPONENTS_H
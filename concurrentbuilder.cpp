@@ -0,0 +1,117 @@
+/**
+ * Building a graph from many threads with lock striped vertex tables
+ *
+ * @author Bill Zhao
+ * @date updated on 10/17/2026
+ */
+
+#include "concurrentbuilder.h"
+#include "graphstats.h"
+#include "threadpool.h"
+#include <functional>
+
+using namespace std;
+
+ConcurrentGraphBuilder::ConcurrentGraphBuilder(bool DirectionalEdges,
+                                               int Stripes)
+    : DirectionalEdges(DirectionalEdges), Vertices(0), Edges(0) {
+  const int Count = Stripes > 0 ? Stripes : DEFAULT_STRIPES;
+  for (int S = 0; S < Count; ++S)
+    this->Stripes.push_back(make_unique<Stripe>());
+}
+
+bool ConcurrentGraphBuilder::add(const string &Label) {
+  bool Added = false;
+  findOrAdd(Label, Added);
+  return Added;
+}
+
+// both ends are found first, each under the lock of its own stripe, then
+// the edge is added under the lock of the stripe that keeps it
+bool ConcurrentGraphBuilder::connect(const string &From, const string &To,
+                                     int Weight) {
+  if (From == To)
+    return false;
+  bool Added = false;
+  Handle FromHandle = findOrAdd(From, Added);
+  Handle ToHandle = findOrAdd(To, Added);
+  if (!DirectionalEdges && ToHandle < FromHandle)
+    swap(FromHandle, ToHandle);
+  if (!addEdge(FromHandle, ToHandle, Weight))
+    return false;
+  Edges.fetch_add(DirectionalEdges ? 1 : 2, memory_order_relaxed);
+  return true;
+}
+
+ConcurrentGraphBuilder::Handle
+ConcurrentGraphBuilder::findOrAdd(const string &Label, bool &Added) {
+  const size_t S = hash<string>()(Label) % Stripes.size();
+  Stripe &Owner = *Stripes[S];
+  lock_guard<mutex> Guard(Owner.Lock);
+  auto Found = Owner.Index.find(Label);
+  int Local = 0;
+  if (Found != Owner.Index.end()) {
+    Local = Found->second;
+  } else {
+    Local = static_cast<int>(Owner.Labels.size());
+    Owner.Index.emplace(Label, Local);
+    Owner.Labels.push_back(Label);
+    Owner.Neighbors.emplace_back();
+    Vertices.fetch_add(1, memory_order_relaxed);
+    Added = true;
+  }
+  return static_cast<Handle>(Local) * Stripes.size() + S;
+}
+
+// repeats are found in the stripe's set of edge ends, so a vertex with
+// many edges does not hold the lock any longer than one with few
+bool ConcurrentGraphBuilder::addEdge(Handle From, Handle To, int Weight) {
+  Stripe &Owner = stripeOf(From);
+  lock_guard<mutex> Guard(Owner.Lock);
+  if (!Owner.Ends.emplace(From, To).second)
+    return false;
+  Owner.Neighbors[From / Stripes.size()].push_back({To, Weight});
+  return true;
+}
+
+// ids are given stripe by stripe, then each thread turns the edges of
+// its stripes into pending edges, written at offsets found beforehand
+int ConcurrentGraphBuilder::addTo(Graph &G, int Threads) {
+  GRAPH_TIMER(Connect);
+  if (G.DirectionalEdges != DirectionalEdges)
+    return -1;
+  const int Count = static_cast<int>(Stripes.size());
+  vector<vector<VertexId>> Ids(Count);
+  vector<size_t> Offsets(Count + 1, 0);
+  for (int S = 0; S < Count; ++S) {
+    Ids[S].resize(Stripes[S]->Labels.size());
+    for (int Local = 0; Local < Ids[S].size(); ++Local)
+      G.add(Stripes[S]->Labels[Local], Ids[S][Local]);
+    for (const auto &Neighbors : Stripes[S]->Neighbors)
+      Offsets[S + 1] += Neighbors.size() * (DirectionalEdges ? 1 : 2);
+    Offsets[S + 1] += Offsets[S];
+  }
+  auto IdOf = [&Ids, Count](Handle V) { return Ids[V % Count][V / Count]; };
+  vector<Graph::PendingEdge> Pending(Offsets[Count]);
+  ThreadPool Pool(Threads);
+  Pool.parallelFor(Count, [&](int Begin, int End, int /*Worker*/) {
+    for (int S = Begin; S < End; ++S) {
+      size_t Next = Offsets[S];
+      const Stripe &Part = *Stripes[S];
+      for (int Local = 0; Local < Part.Neighbors.size(); ++Local) {
+        VertexId From = Ids[S][Local];
+        for (const Adjacent &Neighbor : Part.Neighbors[Local]) {
+          VertexId To = IdOf(Neighbor.To);
+          Pending[Next++] = {From, To, Neighbor.Weight, false};
+          if (!DirectionalEdges)
+            Pending[Next++] = {To, From, Neighbor.Weight, true};
+        }
+      }
+    }
+  });
+  for (auto &Owner : Stripes)
+    Owner = make_unique<Stripe>();
+  Vertices = 0;
+  Edges = 0;
+  return G.addPendingEdges(Pending, &Pool);
+}
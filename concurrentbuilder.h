@@ -0,0 +1,97 @@
+/**
+ * A ConcurrentGraphBuilder collects vertices and edges from many threads
+ * at once, then adds them all to a Graph
+ * Vertices are spread over stripes by the hash of their label, and each
+ * stripe has its own lock for its labels and the edges of its vertices,
+ * so threads only wait for each other when they touch the same stripe
+ * An undirected edge is kept once, by the end with the smaller handle, so
+ * two threads connecting A to B and B to A cannot both add it
+ *
+ * @author Bill Zhao
+ * @date updated on 10/17/2026
+ */
+
+#ifndef CONCURRENTBUILDER_H
+#define CONCURRENTBUILDER_H
+
+#include "graph.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+class ConcurrentGraphBuilder {
+public:
+  // builder for a graph with the given kind of edges, labels are spread
+  // over Stripes stripes, 0 or less for the default
+  explicit ConcurrentGraphBuilder(bool DirectionalEdges = true,
+                                  int Stripes = 0);
+
+  ConcurrentGraphBuilder(const ConcurrentGraphBuilder &) = delete;
+  ConcurrentGraphBuilder &operator=(const ConcurrentGraphBuilder &) = delete;
+
+  // add, connect and the sizes can be called from any number of threads
+
+  // same as Graph::add
+  bool add(const string &Label);
+
+  // same as Graph::connect, when several threads add the same edge one of
+  // them gets true, and its weight is kept
+  bool connect(const string &From, const string &To, int Weight = 0);
+
+  // @return number of vertices and edges so far, undirected edges count
+  // twice as in Graph
+  int verticesSize() const { return Vertices.load(memory_order_relaxed); }
+  int edgesSize() const { return Edges.load(memory_order_relaxed); }
+
+  // add everything to G, as addEdges would, using Threads threads, 0 or
+  // less for one per core, and empty the builder
+  // vertices get ids stripe by stripe, not in the order they were added
+  // must not run while other threads use the builder
+  // @return number of edges added, undirected edges count once, -1 if G is
+  // not directed the same way as the builder, which then adds nothing
+  int addTo(Graph &G, int Threads = 0);
+
+private:
+  enum : int { DEFAULT_STRIPES = 256 };
+  // a vertex is Local * Stripes count + stripe number
+  using Handle = int64_t;
+  struct Adjacent {
+    Handle To;
+    int Weight;
+  };
+  struct EdgeHash {
+    size_t operator()(const pair<Handle, Handle> &Ends) const {
+      return hash<Handle>()(Ends.first * 0x9E3779B97F4A7C15ULL ^ Ends.second);
+    }
+  };
+  struct Stripe {
+    mutex Lock;
+    unordered_map<string, int> Index;
+    vector<string> Labels;
+    // edges kept by each vertex of the stripe
+    vector<vector<Adjacent>> Neighbors;
+    // ends of those edges, to find repeats without scanning a neighbor list
+    unordered_set<pair<Handle, Handle>, EdgeHash> Ends;
+  };
+
+  bool DirectionalEdges;
+  vector<unique_ptr<Stripe>> Stripes;
+  atomic<int> Vertices;
+  atomic<int> Edges;
+
+  Stripe &stripeOf(Handle V) { return *Stripes[V % Stripes.size()]; }
+  // handle of the vertex, adding it if needed, Added is set if it was
+  Handle findOrAdd(const string &Label, bool &Added);
+  // add the edge to From unless From already has one to To
+  bool addEdge(Handle From, Handle To, int Weight);
+};
+
+#endif // CONCURRENTBUILDER_H
@@ -0,0 +1,630 @@
+/**
+ * A CsrGraph is a read-only snapshot of a Graph
+ * Vertices are numbered 0..n-1 in the order they were added to the graph
+ * Traversals give the same results as the Graph they were built from
+ *
+ * @author Bill Zhao
+ * @date updated on 10/17/2026
+ */
+
+#include "csrgraph.h"
+#include "graph.h"
+#include "indexedheap.h"
+#include "threadpool.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+using namespace std;
+
+// the arrays of a snapshot built in memory
+struct CsrGraph::Arrays {
+  vector<int> Offsets{0};
+  vector<int> Targets;
+  vector<int> EdgeWeights;
+  vector<int> InOffsets;
+  vector<int> Sources;
+  vector<int64_t> LabelOffsets{0};
+  vector<char> LabelChars;
+  vector<VertexId> SortedIds;
+};
+
+// empty snapshot
+CsrGraph::CsrGraph() { useArrays(make_shared<Arrays>()); }
+
+// pack the given graph, neighbors keep their sorted order
+CsrGraph::CsrGraph(const Graph &G) {
+  auto Owned = make_shared<Arrays>();
+  const int Size = static_cast<int>(G.AllVertices.size());
+  Owned->Offsets.reserve(Size + 1);
+  Owned->Targets.reserve(G.Edges);
+  Owned->EdgeWeights.reserve(G.Edges);
+  Owned->LabelOffsets.reserve(Size + 1);
+  for (auto Tmp : G.AllVertices) {
+    for (auto Neighbor : Tmp->Neighbors) {
+      Owned->Targets.push_back(Neighbor->To->Id);
+      Owned->EdgeWeights.push_back(Neighbor->Weight);
+    }
+    Owned->Offsets.push_back(static_cast<int>(Owned->Targets.size()));
+    Owned->LabelChars.insert(Owned->LabelChars.end(), Tmp->Label.begin(),
+                             Tmp->Label.end());
+    Owned->LabelOffsets.push_back(
+        static_cast<int64_t>(Owned->LabelChars.size()));
+  }
+  Owned->SortedIds.resize(Size);
+  for (VertexId V = 0; V < Size; ++V)
+    Owned->SortedIds[V] = V;
+  sort(Owned->SortedIds.begin(), Owned->SortedIds.end(),
+       [&G](VertexId A, VertexId B) {
+         return G.AllVertices[A]->Label < G.AllVertices[B]->Label;
+       });
+  if (G.DirectionalEdges) {
+    // counting sort of the edges by target, sources stay in id order
+    vector<int> &InEdgeOffsets = Owned->InOffsets;
+    InEdgeOffsets.assign(Size + 1, 0);
+    for (int To : Owned->Targets)
+      InEdgeOffsets[To + 1]++;
+    for (int V = 0; V < Size; ++V)
+      InEdgeOffsets[V + 1] += InEdgeOffsets[V];
+    Owned->Sources.resize(Owned->Targets.size());
+    vector<int> Next(InEdgeOffsets.begin(), InEdgeOffsets.end() - 1);
+    for (int From = 0; From < Size; ++From) {
+      for (int E = Owned->Offsets[From]; E < Owned->Offsets[From + 1]; ++E)
+        Owned->Sources[Next[Owned->Targets[E]]++] = From;
+    }
+  }
+  DirectionalEdges = G.DirectionalEdges;
+  useArrays(Owned);
+}
+
+// point every array at the vectors, and keep the vectors alive
+void CsrGraph::useArrays(shared_ptr<Arrays> Owned) {
+  VertexCount = static_cast<int>(Owned->Offsets.size()) - 1;
+  Offsets = ArrayView<int>(Owned->Offsets);
+  Targets = ArrayView<int>(Owned->Targets);
+  EdgeWeights = ArrayView<int>(Owned->EdgeWeights);
+  InOffsets = ArrayView<int>(Owned->InOffsets);
+  Sources = ArrayView<int>(Owned->Sources);
+  LabelOffsets = ArrayView<int64_t>(Owned->LabelOffsets);
+  LabelChars = ArrayView<char>(Owned->LabelChars);
+  SortedIds = ArrayView<VertexId>(Owned->SortedIds);
+  Storage = Owned;
+}
+
+// undirected graphs have the same edges in and out
+ArrayView<int> CsrGraph::inOffsets() const {
+  return DirectionalEdges ? InOffsets : Offsets;
+}
+
+ArrayView<int> CsrGraph::inSources() const {
+  return DirectionalEdges ? Sources : Targets;
+}
+
+// the characters of the label inside the label table, nothing is copied
+ArrayView<char> CsrGraph::labelChars(VertexId Id) const {
+  return ArrayView<char>(LabelChars.begin() + LabelOffsets[Id],
+                         LabelOffsets[Id + 1] - LabelOffsets[Id]);
+}
+
+// reuses the capacity of Label, so loops calling it do not allocate
+const string &CsrGraph::labelInto(VertexId Id, string &Label) const {
+  ArrayView<char> Chars = labelChars(Id);
+  Label.assign(Chars.begin(), Chars.end());
+  return Label;
+}
+
+// compare the bytes of the label, shorter label first if one is a prefix
+int CsrGraph::compareLabel(VertexId Id, const string &Label) const {
+  ArrayView<char> Chars = labelChars(Id);
+  size_t Length = Chars.size();
+  int Result = memcmp(Chars.begin(), Label.data(), min(Length, Label.size()));
+  if (Result != 0)
+    return Result;
+  return Length < Label.size() ? -1 : (Length > Label.size() ? 1 : 0);
+}
+
+// get the id for the given label, NO_VERTEX if not found
+VertexId CsrGraph::idOf(const string &Label) const {
+  // binary search over the ids sorted by label
+  int Low = 0;
+  int High = VertexCount;
+  while (Low < High) {
+    int Middle = Low + (High - Low) / 2;
+    if (compareLabel(SortedIds[Middle], Label) < 0)
+      Low = Middle + 1;
+    else
+      High = Middle;
+  }
+  if (Low < VertexCount && compareLabel(SortedIds[Low], Label) == 0)
+    return SortedIds[Low];
+  return NO_VERTEX;
+}
+
+// get the label of the vertex with the given id
+string CsrGraph::labelOf(VertexId Id) const {
+  if (Id < 0 || Id >= VertexCount)
+    throw out_of_range("CsrGraph::labelOf");
+  ArrayView<char> Chars = labelChars(Id);
+  return string(Chars.begin(), Chars.end());
+}
+
+// return true if vertex is in the graph
+bool CsrGraph::contains(const string &Label) const {
+  return idOf(Label) != NO_VERTEX;
+}
+
+// get the number of vertices in the graph
+int CsrGraph::verticesSize() const { return VertexCount; }
+
+// get the number of edges in the graph
+int CsrGraph::edgesSize() const { return static_cast<int>(Targets.size()); }
+
+// get the number of neighbors of a given vertex label
+int CsrGraph::neighborsSize(const string &Label) const {
+  int V = idOf(Label);
+  if (V == NO_VERTEX)
+    return -1;
+  return Offsets[V + 1] - Offsets[V];
+}
+
+// get the edges of the given vertex as a string
+string CsrGraph::getEdgesAsString(const string &Label) const {
+  int V = idOf(Label);
+  string Ans;
+  if (V == NO_VERTEX)
+    return Ans;
+  for (int E = Offsets[V]; E < Offsets[V + 1]; ++E) {
+    if (E != Offsets[V])
+      Ans += ",";
+    ArrayView<char> Chars = labelChars(Targets[E]);
+    Ans.append(Chars.begin(), Chars.end());
+    Ans += "(" + to_string(EdgeWeights[E]) + ")";
+  }
+  return Ans;
+}
+
+// dfs traversal, explicit stack of (vertex, next edge to look at)
+// visits vertices in the same order as the recursive Graph::dfs
+void CsrGraph::dfs(const string &StartLabel,
+                   void Visit(const string &Label)) const {
+  int Start = idOf(StartLabel);
+  if (Start == NO_VERTEX)
+    return;
+  vector<bool> Seen(VertexCount, false);
+  vector<pair<int, int>> Stack;
+  string Label;
+  Visit(labelInto(Start, Label));
+  Seen[Start] = true;
+  Stack.emplace_back(Start, Offsets[Start]);
+  while (!Stack.empty()) {
+    int Curr = Stack.back().first;
+    int &E = Stack.back().second;
+    if (E == Offsets[Curr + 1]) {
+      Stack.pop_back();
+      continue;
+    }
+    int Next = Targets[E++];
+    if (!Seen[Next]) {
+      Visit(labelInto(Next, Label));
+      Seen[Next] = true;
+      Stack.emplace_back(Next, Offsets[Next]);
+    }
+  }
+}
+
+// bfs traversal, the queue is a vector read from the front
+void CsrGraph::bfs(const string &StartLabel,
+                   void Visit(const string &Label)) const {
+  int Start = idOf(StartLabel);
+  if (Start == NO_VERTEX)
+    return;
+  vector<bool> Seen(VertexCount, false);
+  vector<int> Queue;
+  string Label;
+  Queue.push_back(Start);
+  Seen[Start] = true;
+  for (int Head = 0; Head < Queue.size(); ++Head) {
+    int Curr = Queue[Head];
+    Visit(labelInto(Curr, Label));
+    for (int E = Offsets[Curr]; E < Offsets[Curr + 1]; ++E) {
+      if (!Seen[Targets[E]]) {
+        Seen[Targets[E]] = true;
+        Queue.push_back(Targets[E]);
+      }
+    }
+  }
+}
+
+// shortest path weights and previous vertex from StartLabel
+pair<map<string, int>, map<string, string>>
+CsrGraph::dijkstra(const string &StartLabel) const {
+  map<string, int> Weights;
+  map<string, string> Previous;
+  VertexId Start = idOf(StartLabel);
+  if (Start == NO_VERTEX)
+    return make_pair(Weights, Previous);
+  auto Paths = dijkstra(Start);
+  return toLabelMaps(Paths.first, Paths.second);
+}
+
+// label maps for every vertex reached, other than the start vertex
+pair<map<string, int>, map<string, string>>
+CsrGraph::toLabelMaps(const vector<int> &Dist,
+                      const vector<VertexId> &Prev) const {
+  map<string, int> Weights;
+  map<string, string> Previous;
+  for (VertexId V = 0; V < VertexCount; ++V) {
+    if (Prev[V] != NO_VERTEX) {
+      const string Label = labelOf(V);
+      Weights[Label] = Dist[V];
+      Previous[Label] = labelOf(Prev[V]);
+    }
+  }
+  return make_pair(Weights, Previous);
+}
+
+// shortest distances and previous vertices as dense arrays indexed by id
+pair<vector<int>, vector<VertexId>> CsrGraph::dijkstra(VertexId Start) const {
+  vector<int> Dist(VertexCount, UNREACHABLE);
+  vector<VertexId> Prev(VertexCount, NO_VERTEX);
+  if (Start < 0 || Start >= VertexCount)
+    return make_pair(Dist, Prev);
+  // vertices are settled once they leave the heap
+  vector<bool> Done(VertexCount, false);
+  IndexedHeap<int> Queue(static_cast<int>(VertexCount));
+  Dist[Start] = 0;
+  Queue.push(Start, 0);
+  while (!Queue.empty()) {
+    VertexId Curr = Queue.pop();
+    Done[Curr] = true;
+    for (int E = Offsets[Curr]; E < Offsets[Curr + 1]; ++E) {
+      VertexId Next = Targets[E];
+      int NewDist = pathLength(Dist[Curr], EdgeWeights[E]);
+      if (!Done[Next] && NewDist < Dist[Next]) {
+        Dist[Next] = NewDist;
+        Prev[Next] = Curr;
+        Queue.pushOrDecrease(Next, NewDist);
+      }
+    }
+  }
+  return make_pair(Dist, Prev);
+}
+
+// delta-stepping with label maps, same contract as dijkstra
+pair<map<string, int>, map<string, string>>
+CsrGraph::deltaStepping(const string &StartLabel, int Delta,
+                        int Threads) const {
+  VertexId Start = idOf(StartLabel);
+  if (Start == NO_VERTEX)
+    return make_pair(map<string, int>(), map<string, string>());
+  auto Paths = deltaStepping(Start, Delta, Threads);
+  return toLabelMaps(Paths.first, Paths.second);
+}
+
+// distance in the high half and previous vertex in the low half, so the
+// smaller of two packed values has the shorter distance, then smaller id
+static uint64_t packPath(int Dist, VertexId Prev) {
+  return (static_cast<uint64_t>(static_cast<uint32_t>(Dist)) << 32) |
+         static_cast<uint32_t>(Prev);
+}
+
+static int unpackDist(uint64_t Path) { return static_cast<int>(Path >> 32); }
+
+static VertexId unpackPrev(uint64_t Path) {
+  return static_cast<VertexId>(static_cast<uint32_t>(Path));
+}
+
+// Meyer and Sanders delta-stepping
+// vertices wait in buckets of width Delta by tentative distance, the
+// smallest bucket is emptied by relaxing light edges (weight <= Delta) in
+// parallel until no vertex falls back into it, then the heavy edges of
+// everything it held are relaxed once
+// packed distances are unsigned, so negative weights are refused before
+// starting and a sum past an int stops the search once every thread is done
+pair<vector<int>, vector<VertexId>>
+CsrGraph::deltaStepping(VertexId Start, int Delta, int Threads) const {
+  vector<int> Dist(VertexCount, UNREACHABLE);
+  vector<VertexId> Prev(VertexCount, NO_VERTEX);
+  if (Start < 0 || Start >= VertexCount)
+    return make_pair(Dist, Prev);
+  int MaxWeight = 1;
+  for (int Weight : EdgeWeights) {
+    if (Weight < 0)
+      throw invalid_argument("delta-stepping needs weights of 0 or more");
+    MaxWeight = max(MaxWeight, Weight);
+  }
+  if (Delta <= 0) {
+    // heaviest weight over the average degree, at least 1
+    int AverageDegree = max(1, edgesSize() / VertexCount);
+    Delta = max(1, MaxWeight / AverageDegree);
+  }
+
+  ThreadPool Pool(Threads);
+  vector<atomic<uint64_t>> Paths(VertexCount);
+  for (auto &Path : Paths)
+    Path.store(packPath(UNREACHABLE, NO_VERTEX), memory_order_relaxed);
+  Paths[Start].store(packPath(0, NO_VERTEX), memory_order_relaxed);
+  // vertices whose distance went down, one buffer per worker
+  vector<vector<VertexId>> Improved(Pool.size());
+  atomic<bool> Overflow(false);
+  // lower the distance of To if going through From is shorter
+  auto Relax = [&](VertexId From, int FromDist, int E, int Worker) {
+    VertexId To = Targets[E];
+    // zero weight cycles must not give the start vertex a previous
+    if (To == Start)
+      return;
+    const int64_t NewDist = static_cast<int64_t>(FromDist) + EdgeWeights[E];
+    if (NewDist >= UNREACHABLE) {
+      Overflow.store(true, memory_order_relaxed);
+      return;
+    }
+    uint64_t NewPath = packPath(static_cast<int>(NewDist), From);
+    uint64_t OldPath = Paths[To].load(memory_order_relaxed);
+    while (NewPath < OldPath) {
+      if (Paths[To].compare_exchange_weak(OldPath, NewPath,
+                                          memory_order_relaxed)) {
+        if (unpackDist(NewPath) < unpackDist(OldPath))
+          Improved[Worker].push_back(To);
+        return;
+      }
+    }
+  };
+
+  vector<vector<VertexId>> Buckets(1, vector<VertexId>{Start});
+  // bucket each vertex was last put in, to avoid duplicates
+  vector<int> BucketOf(VertexCount, -1);
+  BucketOf[Start] = 0;
+  // move improved vertices into the bucket for their new distance
+  auto FillBuckets = [&]() {
+    for (auto &Buffer : Improved) {
+      for (VertexId V : Buffer) {
+        int Bucket = unpackDist(Paths[V].load(memory_order_relaxed)) / Delta;
+        if (BucketOf[V] == Bucket)
+          continue;
+        BucketOf[V] = Bucket;
+        if (Bucket >= Buckets.size())
+          Buckets.resize(Bucket + 1);
+        Buckets[Bucket].push_back(V);
+      }
+      Buffer.clear();
+    }
+  };
+
+  // relax the light or the heavy edges of the given vertices in parallel
+  auto RelaxAll = [&](const vector<VertexId> &Vertices, bool Heavy) {
+    Pool.parallelFor(
+        static_cast<int>(Vertices.size()), [&](int Begin, int End, int Worker) {
+          for (int I = Begin; I < End; ++I) {
+            VertexId V = Vertices[I];
+            int VDist = unpackDist(Paths[V].load(memory_order_relaxed));
+            for (int E = Offsets[V]; E < Offsets[V + 1]; ++E) {
+              if ((EdgeWeights[E] > Delta) == Heavy)
+                Relax(V, VDist, E, Worker);
+            }
+          }
+        });
+  };
+
+  vector<VertexId> Frontier;
+  vector<VertexId> Settled;
+  for (int Bucket = 0; Bucket < Buckets.size(); ++Bucket) {
+    Settled.clear();
+    while (!Buckets[Bucket].empty()) {
+      Frontier.clear();
+      for (VertexId V : Buckets[Bucket]) {
+        // skip vertices that have since moved to a lower bucket
+        if (BucketOf[V] == Bucket) {
+          BucketOf[V] = -1;
+          Frontier.push_back(V);
+          Settled.push_back(V);
+        }
+      }
+      Buckets[Bucket].clear();
+      RelaxAll(Frontier, false);
+      FillBuckets();
+    }
+    sort(Settled.begin(), Settled.end());
+    Settled.erase(unique(Settled.begin(), Settled.end()), Settled.end());
+    RelaxAll(Settled, true);
+    FillBuckets();
+    vector<VertexId>().swap(Buckets[Bucket]);
+    if (Overflow.load(memory_order_relaxed))
+      throw overflow_error("path length does not fit in an int");
+  }
+
+  for (VertexId V = 0; V < VertexCount; ++V) {
+    uint64_t Path = Paths[V].load(memory_order_relaxed);
+    Dist[V] = unpackDist(Path);
+    Prev[V] = unpackPrev(Path);
+  }
+  return make_pair(Dist, Prev);
+}
+
+// Beamer, Asanovic and Patterson direction-optimizing bfs
+// top-down steps claim unvisited neighbors of the frontier with a
+// compare-exchange on Parents, bottom-up steps let every unvisited vertex
+// look for any in-neighbor in the frontier bitmap and stop at the first one
+pair<vector<int>, vector<VertexId>>
+CsrGraph::parallelBfs(VertexId Start, int Threads,
+                      void VisitLevel(int Depth,
+                                      const vector<VertexId> &Level)) const {
+  // switch to bottom-up once the frontier has more than 1/Alpha of the
+  // unvisited edges, back to top-down below 1/Beta of the vertices
+  const long long Alpha = 14;
+  const long long Beta = 24;
+  vector<int> Depth(VertexCount, -1);
+  vector<VertexId> Parent(VertexCount, NO_VERTEX);
+  if (Start < 0 || Start >= VertexCount)
+    return make_pair(Depth, Parent);
+
+  ThreadPool Pool(Threads);
+  ArrayView<int> ReverseOffsets = inOffsets();
+  ArrayView<int> ReverseSources = inSources();
+  // the start vertex is its own parent while running, to mark it visited
+  vector<atomic<VertexId>> Parents(VertexCount);
+  for (auto &P : Parents)
+    P.store(NO_VERTEX, memory_order_relaxed);
+  Parents[Start].store(Start, memory_order_relaxed);
+  Depth[Start] = 0;
+
+  // the frontier is a list of ids for top-down steps, a bitmap for bottom-up
+  const int Words = (VertexCount + 63) / 64;
+  vector<VertexId> Frontier{Start};
+  vector<uint64_t> FrontierBits;
+  vector<uint64_t> NextBits;
+  bool BottomUp = false;
+  long long FrontierSize = 1;
+  long long FrontierEdges = Offsets[Start + 1] - Offsets[Start];
+  long long UnvisitedEdges = edgesSize() - FrontierEdges;
+  // per worker results of a step, padded to keep workers off each other's
+  // cache lines
+  struct WorkerResult {
+    vector<VertexId> Next;
+    long long Size = 0;
+    long long Edges = 0;
+    char Padding[64];
+  };
+  vector<WorkerResult> Results(Pool.size());
+
+  // list of the vertices in a bitmap, sorted by id
+  auto BitsToList = [&](const vector<uint64_t> &Bits) {
+    vector<VertexId> List;
+    for (int W = 0; W < Words; ++W) {
+      for (uint64_t Word = Bits[W]; Word != 0; Word &= Word - 1)
+        List.push_back(W * 64 + __builtin_ctzll(Word));
+    }
+    return List;
+  };
+
+  for (int Level = 0; FrontierSize > 0; ++Level) {
+    if (VisitLevel != nullptr) {
+      vector<VertexId> Current = BottomUp ? BitsToList(FrontierBits) : Frontier;
+      if (!BottomUp)
+        sort(Current.begin(), Current.end());
+      VisitLevel(Level, Current);
+    }
+    if (!BottomUp && FrontierEdges > UnvisitedEdges / Alpha) {
+      BottomUp = true;
+      FrontierBits.assign(Words, 0);
+      for (VertexId V : Frontier)
+        FrontierBits[V / 64] |= uint64_t{1} << (V % 64);
+    } else if (BottomUp && FrontierSize < VertexCount / Beta) {
+      BottomUp = false;
+      Frontier = BitsToList(FrontierBits);
+    }
+    for (auto &Result : Results) {
+      Result.Size = 0;
+      Result.Edges = 0;
+    }
+
+    if (BottomUp) {
+      // every 64 vertex word of the next bitmap is written by one worker
+      NextBits.assign(Words, 0);
+      Pool.parallelFor(Words, [&](int Begin, int End, int Worker) {
+        WorkerResult &Result = Results[Worker];
+        for (int W = Begin; W < End; ++W) {
+          int Last = min(VertexCount, (W + 1) * 64);
+          for (VertexId V = W * 64; V < Last; ++V) {
+            if (Parents[V].load(memory_order_relaxed) != NO_VERTEX)
+              continue;
+            for (int E = ReverseOffsets[V]; E < ReverseOffsets[V + 1]; ++E) {
+              VertexId U = ReverseSources[E];
+              if ((FrontierBits[U / 64] >> (U % 64)) & 1) {
+                Parents[V].store(U, memory_order_relaxed);
+                Depth[V] = Level + 1;
+                NextBits[W] |= uint64_t{1} << (V % 64);
+                Result.Size++;
+                Result.Edges += Offsets[V + 1] - Offsets[V];
+                break;
+              }
+            }
+          }
+        }
+      });
+      FrontierBits.swap(NextBits);
+    } else {
+      Pool.parallelFor(
+          static_cast<int>(Frontier.size()),
+          [&](int Begin, int End, int Worker) {
+            WorkerResult &Result = Results[Worker];
+            for (int I = Begin; I < End; ++I) {
+              VertexId U = Frontier[I];
+              for (int E = Offsets[U]; E < Offsets[U + 1]; ++E) {
+                VertexId V = Targets[E];
+                VertexId Unvisited = NO_VERTEX;
+                if (Parents[V].load(memory_order_relaxed) == NO_VERTEX &&
+                    Parents[V].compare_exchange_strong(Unvisited, U,
+                                                       memory_order_relaxed)) {
+                  Depth[V] = Level + 1;
+                  Result.Next.push_back(V);
+                  Result.Size++;
+                  Result.Edges += Offsets[V + 1] - Offsets[V];
+                }
+              }
+            }
+          });
+      Frontier.clear();
+      for (auto &Result : Results) {
+        Frontier.insert(Frontier.end(), Result.Next.begin(), Result.Next.end());
+        Result.Next.clear();
+      }
+    }
+    FrontierSize = 0;
+    FrontierEdges = 0;
+    for (auto &Result : Results) {
+      FrontierSize += Result.Size;
+      FrontierEdges += Result.Edges;
+    }
+    UnvisitedEdges -= FrontierEdges;
+  }
+
+  for (VertexId V = 0; V < VertexCount; ++V)
+    Parent[V] = Parents[V].load(memory_order_relaxed);
+  Parent[Start] = NO_VERTEX;
+  return make_pair(Depth, Parent);
+}
+
+// prim's algorithm from StartLabel, edges visited in the order they are added
+int64_t CsrGraph::mst(const string &StartLabel,
+                      void Visit(const string &From, const string &To,
+                                 int Weight)) const {
+  assert(!DirectionalEdges);
+  int Start = idOf(StartLabel);
+  if (Start == NO_VERTEX)
+    return -1;
+  vector<bool> InTree(VertexCount, false);
+  // (weight, to, from), lightest edge on top
+  priority_queue<tuple<int, int, int>, vector<tuple<int, int, int>>,
+                 greater<tuple<int, int, int>>>
+      Queue;
+  int64_t Ans = 0;
+  string FromLabel;
+  string ToLabel;
+  InTree[Start] = true;
+  for (int E = Offsets[Start]; E < Offsets[Start + 1]; ++E)
+    Queue.emplace(EdgeWeights[E], Targets[E], Start);
+  while (!Queue.empty()) {
+    int Weight;
+    int To;
+    int From;
+    tie(Weight, To, From) = Queue.top();
+    Queue.pop();
+    if (InTree[To])
+      continue;
+    InTree[To] = true;
+    Visit(labelInto(From, FromLabel), labelInto(To, ToLabel), Weight);
+    Ans += Weight;
+    for (int E = Offsets[To]; E < Offsets[To + 1]; ++E) {
+      if (!InTree[Targets[E]])
+        Queue.emplace(EdgeWeights[E], Targets[E], To);
+    }
+  }
+  return Ans;
+}
@@ -0,0 +1,190 @@
+/**
+ * A CsrGraph is a read-only snapshot of a Graph
+ * Vertices are numbered 0..n-1 in the order they were added to the graph
+ * The edges of vertex i are Targets[Offsets[i]] to Targets[Offsets[i + 1] - 1]
+ * with the matching weights in EdgeWeights, in the same order as the graph
+ * Directed graphs also keep the reverse edges, the sources of the edges into
+ * vertex i are Sources[InOffsets[i]] to Sources[InOffsets[i + 1] - 1]
+ * Traversals give the same results as the Graph they were built from
+ * A snapshot can be written to a binary file and mapped back into memory,
+ * queries then run directly on the mapped file
+ *
+ * @author Bill Zhao
+ * @date updated on 10/17/2026
+ */
+
+#ifndef CSRGRAPH_H
+#define CSRGRAPH_H
+
+#include "components.h"
+#include "vertex.h"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// forward declaration for class Graph
+class Graph;
+
+// a read-only array that does not own its memory
+template <typename T> class ArrayView {
+public:
+  ArrayView() = default;
+  ArrayView(const T *Data, size_t Size) : Data(Data), Size(Size) {}
+  explicit ArrayView(const vector<T> &Values)
+      : Data(Values.data()), Size(Values.size()) {}
+  const T &operator[](size_t I) const { return Data[I]; }
+  size_t size() const { return Size; }
+  const T *begin() const { return Data; }
+  const T *end() const { return Data + Size; }
+
+private:
+  const T *Data = nullptr;
+  size_t Size = 0;
+};
+
+class CsrGraph {
+public:
+  // empty snapshot
+  CsrGraph();
+
+  // pack all vertices and edges of the given graph
+  explicit CsrGraph(const Graph &G);
+
+  // write the snapshot to a binary file, in this machine's byte order
+  // @return true if the file was written
+  bool writeFile(const string &Filename) const;
+
+  // replace this snapshot with one mapped from a file made by writeFile
+  // nothing is parsed or copied, the file stays mapped as long as this
+  // snapshot, or a copy of it, uses it
+  // the header is always checked, so arrays that do not fit the file are
+  // rejected, and only the pages queries touch are read
+  // Verify also checks every offset, id and the label order, O(V + E) and
+  // reading the whole file, so a corrupt file is rejected instead of read
+  // out of bounds or searched wrongly by later queries; without it the
+  // file must be one writeFile made
+  // @return true if the file was mapped, false leaves the snapshot unchanged
+  bool mapFile(const string &Filename, bool Verify = false);
+
+  // @return id of the vertex, same as in the graph, NO_VERTEX if not found
+  VertexId idOf(const string &Label) const;
+
+  // @return label of the vertex with the given id, throws if id is not valid
+  string labelOf(VertexId Id) const;
+
+  // @return true if vertex is in the graph
+  bool contains(const string &Label) const;
+
+  // @return total number of vertices
+  int verticesSize() const;
+
+  // @return total number of edges
+  int edgesSize() const;
+
+  // @return number of edges from given vertex, -1 if vertex not found
+  int neighborsSize(const string &Label) const;
+
+  // @return string representing edges and weights, "" if vertex not found
+  string getEdgesAsString(const string &Label) const;
+
+  // depth-first traversal starting from given startLabel
+  void dfs(const string &StartLabel, void Visit(const string &Label)) const;
+
+  // breadth-first traversal starting from startLabel
+  void bfs(const string &StartLabel, void Visit(const string &Label)) const;
+
+  // dijkstra's algorithm to find shortest distance to all other vertices
+  // @return a pair made up of two map objects, Weights and Previous
+  pair<map<string, int>, map<string, string>>
+  dijkstra(const string &StartLabel) const;
+  // same as above using dense arrays indexed by vertex id
+  // distance is UNREACHABLE and previous is NO_VERTEX for unreachable
+  // vertices, the start vertex has distance 0 and previous NO_VERTEX
+  // both throw overflow_error as Graph::dijkstra does
+  pair<vector<int>, vector<VertexId>> dijkstra(VertexId Start) const;
+
+  // parallel delta-stepping shortest paths, same distances as dijkstra
+  // when there are several shortest paths, previous is the smallest id
+  // Delta is the bucket width, 0 or less to pick one from the edge weights
+  // Threads is the number of threads to use, 0 or less for one per core
+  // throws invalid_argument if an edge weight is negative, and
+  // overflow_error as dijkstra does
+  pair<map<string, int>, map<string, string>>
+  deltaStepping(const string &StartLabel, int Delta = 0,
+                int Threads = 0) const;
+  pair<vector<int>, vector<VertexId>>
+  deltaStepping(VertexId Start, int Delta = 0, int Threads = 0) const;
+
+  // level synchronous parallel bfs, each level is expanded either top-down
+  // from the frontier or bottom-up from the unvisited vertices, whichever
+  // looks at fewer edges (direction-optimizing bfs)
+  // VisitLevel, if given, is called with each level's vertices sorted by id
+  // Threads is the number of threads to use, 0 or less for one per core
+  // @return a pair of Depth and Parent arrays indexed by id, Depth is -1 and
+  // Parent is NO_VERTEX for unreachable vertices, Parent is NO_VERTEX for
+  // the start vertex, for other vertices it is a neighbor one level up
+  pair<vector<int>, vector<VertexId>> parallelBfs(
+      VertexId Start, int Threads = 0,
+      void VisitLevel(int Depth, const vector<VertexId> &Level) = nullptr) const;
+
+  // minimum spanning tree of the component containing StartLabel
+  // ONLY works for NONDIRECTED graphs
+  // @return length of the minimum spanning tree or -1 if start vertex not
+  // found, summed in 64 bits as Graph::mst does
+  int64_t mst(const string &StartLabel,
+              void Visit(const string &From, const string &To,
+                         int Weight)) const;
+
+  // strongly connected components found by several threads, for large
+  // graphs: vertices without edges into or out of the others are removed,
+  // a forward and a backward search from a high degree vertex find the
+  // largest component, then each vertex takes the largest id that reaches
+  // it and a backward search from each such id among the vertices that
+  // took it finds its component, until few vertices are left for tarjan
+  // components are numbered in no particular order
+  // Threads is the number of threads to use, 0 or less for one per core
+  Components stronglyConnected(int Threads = 0) const;
+
+private:
+  bool DirectionalEdges = true;
+  int VertexCount = 0;
+  // Offsets has one entry per vertex plus one, Targets and EdgeWeights have
+  // one entry per edge
+  ArrayView<int> Offsets;
+  ArrayView<int> Targets;
+  ArrayView<int> EdgeWeights;
+  // reverse edges, only for directed graphs since undirected graphs have
+  // every edge both ways, use inOffsets() and inSources()
+  ArrayView<int> InOffsets;
+  ArrayView<int> Sources;
+  // labels back to back, label i is LabelChars[LabelOffsets[i]] up to
+  // LabelChars[LabelOffsets[i + 1] - 1]
+  ArrayView<int64_t> LabelOffsets;
+  ArrayView<char> LabelChars;
+  // ids sorted by label, to find a label with binary search
+  ArrayView<VertexId> SortedIds;
+  // owns the memory all the arrays point into, either vectors built from a
+  // graph or a mapped file, shared between copies of the snapshot
+  shared_ptr<const void> Storage;
+
+  // point the arrays at the vectors in Storage
+  struct Arrays;
+  void useArrays(shared_ptr<Arrays> Owned);
+  // label of a valid id, as a view into LabelChars or copied into Label
+  ArrayView<char> labelChars(VertexId Id) const;
+  const string &labelInto(VertexId Id, string &Label) const;
+  // compare the label of vertex Id with Label, like string::compare
+  int compareLabel(VertexId Id, const string &Label) const;
+  // offsets and sources of the edges into each vertex
+  ArrayView<int> inOffsets() const;
+  ArrayView<int> inSources() const;
+  // convert dense shortest path arrays into the label maps used by dijkstra
+  pair<map<string, int>, map<string, string>>
+  toLabelMaps(const vector<int> &Dist, const vector<VertexId> &Prev) const;
+};
+
+#endif // CSRGRAPH_H
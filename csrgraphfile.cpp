@@ -0,0 +1,237 @@
+/**
+ * Binary file format for CsrGraph
+ * The file is a fixed size header followed by the arrays of the snapshot,
+ * each starting on an 8 byte boundary, in this machine's byte order
+ * Mapping the file gives arrays that can be used as they are
+ *
+ * @author Bill Zhao
+ * @date updated on 10/17/2026
+ */
+
+#include "csrgraph.h"
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <limits>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace {
+
+// bumped whenever the layout changes, older files are rejected
+const uint32_t FORMAT_VERSION = 1;
+const char MAGIC[8] = {'C', 'S', 'R', 'G', 'R', 'A', 'P', 'H'};
+
+struct FileHeader {
+  char Magic[8];
+  uint32_t FormatVersion;
+  uint32_t DirectionalEdges;
+  int64_t VertexCount;
+  int64_t EdgeCount;
+  int64_t LabelBytes;
+  // where each array starts, in bytes from the start of the file
+  int64_t OffsetsAt;
+  int64_t TargetsAt;
+  int64_t WeightsAt;
+  int64_t InOffsetsAt;
+  int64_t SourcesAt;
+  int64_t LabelOffsetsAt;
+  int64_t LabelCharsAt;
+  int64_t SortedIdsAt;
+  int64_t FileSize;
+};
+
+// a mapped file, unmapped when the last snapshot using it goes away
+struct MappedFile {
+  void *Address = nullptr;
+  size_t Length = 0;
+  MappedFile(void *Address, size_t Length)
+      : Address(Address), Length(Length) {}
+  ~MappedFile() { munmap(Address, Length); }
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+};
+
+// round up to the next multiple of 8
+int64_t align(int64_t Position) { return (Position + 7) & ~int64_t{7}; }
+
+// write an array and pad it to a multiple of 8 bytes
+template <typename T>
+void writeArray(ofstream &Output, const ArrayView<T> &Values) {
+  int64_t Bytes = static_cast<int64_t>(Values.size() * sizeof(T));
+  if (Bytes > 0)
+    Output.write(reinterpret_cast<const char *>(Values.begin()), Bytes);
+  static const char Zeros[8] = {};
+  Output.write(Zeros, align(Bytes) - Bytes);
+}
+
+// true if Count values of type T starting at At fit in the file and are
+// aligned for T
+template <typename T>
+bool fits(int64_t At, int64_t Count, int64_t FileSize) {
+  return At >= static_cast<int64_t>(sizeof(FileHeader)) && Count >= 0 &&
+         At % alignof(T) == 0 &&
+         Count <= (FileSize - At) / static_cast<int64_t>(sizeof(T));
+}
+
+// true if Offsets starts at 0, never goes down and ends at Last
+template <typename T> bool ascending(const ArrayView<T> &Offsets, T Last) {
+  if (Offsets.size() == 0 || Offsets[0] != 0 ||
+      Offsets[Offsets.size() - 1] != Last)
+    return false;
+  for (size_t I = 1; I < Offsets.size(); ++I) {
+    if (Offsets[I] < Offsets[I - 1])
+      return false;
+  }
+  return true;
+}
+
+// true if every value is an id below Count
+bool validIds(const ArrayView<int> &Ids, int64_t Count) {
+  for (int Id : Ids) {
+    if (Id < 0 || Id >= Count)
+      return false;
+  }
+  return true;
+}
+
+// true if the labels of Ids strictly ascend in the order idOf searches
+// them, the offsets must already be checked
+bool sortedLabels(const ArrayView<VertexId> &Ids,
+                  const ArrayView<int64_t> &LabelOffsets, const char *Chars) {
+  for (size_t I = 1; I < Ids.size(); ++I) {
+    const int64_t At = LabelOffsets[Ids[I - 1]];
+    const int64_t Length = LabelOffsets[Ids[I - 1] + 1] - At;
+    const int64_t NextAt = LabelOffsets[Ids[I]];
+    const int64_t NextLength = LabelOffsets[Ids[I] + 1] - NextAt;
+    int Result = memcmp(Chars + At, Chars + NextAt, min(Length, NextLength));
+    if (Result > 0 || (Result == 0 && Length >= NextLength))
+      return false;
+  }
+  return true;
+}
+
+} // namespace
+
+// header, then the arrays in the order they are listed in the header
+bool CsrGraph::writeFile(const string &Filename) const {
+  ofstream Output(Filename, ios::binary | ios::trunc);
+  if (!Output.is_open())
+    return false;
+  FileHeader Header;
+  memset(&Header, 0, sizeof(Header));
+  memcpy(Header.Magic, MAGIC, sizeof(MAGIC));
+  Header.FormatVersion = FORMAT_VERSION;
+  Header.DirectionalEdges = DirectionalEdges ? 1 : 0;
+  Header.VertexCount = VertexCount;
+  Header.EdgeCount = static_cast<int64_t>(Targets.size());
+  Header.LabelBytes = static_cast<int64_t>(LabelChars.size());
+  int64_t At = align(sizeof(FileHeader));
+  auto Place = [&At](int64_t Bytes) {
+    int64_t Start = At;
+    At = align(At + Bytes);
+    return Start;
+  };
+  Header.OffsetsAt = Place(Offsets.size() * sizeof(int));
+  Header.TargetsAt = Place(Targets.size() * sizeof(int));
+  Header.WeightsAt = Place(EdgeWeights.size() * sizeof(int));
+  Header.InOffsetsAt = Place(InOffsets.size() * sizeof(int));
+  Header.SourcesAt = Place(Sources.size() * sizeof(int));
+  Header.LabelOffsetsAt = Place(LabelOffsets.size() * sizeof(int64_t));
+  Header.LabelCharsAt = Place(LabelChars.size());
+  Header.SortedIdsAt = Place(SortedIds.size() * sizeof(VertexId));
+  Header.FileSize = At;
+
+  Output.write(reinterpret_cast<const char *>(&Header), sizeof(Header));
+  static const char Zeros[8] = {};
+  Output.write(Zeros, align(sizeof(FileHeader)) - sizeof(FileHeader));
+  writeArray(Output, Offsets);
+  writeArray(Output, Targets);
+  writeArray(Output, EdgeWeights);
+  writeArray(Output, InOffsets);
+  writeArray(Output, Sources);
+  writeArray(Output, LabelOffsets);
+  writeArray(Output, LabelChars);
+  writeArray(Output, SortedIds);
+  return static_cast<bool>(Output);
+}
+
+// map the whole file read-only and point the arrays into it
+// only the header is read unless the arrays are to be checked
+bool CsrGraph::mapFile(const string &Filename, bool Verify) {
+  int File = open(Filename.c_str(), O_RDONLY);
+  if (File == -1)
+    return false;
+  struct stat Info;
+  if (fstat(File, &Info) != 0 || Info.st_size < sizeof(FileHeader)) {
+    close(File);
+    return false;
+  }
+  void *Address = mmap(nullptr, Info.st_size, PROT_READ, MAP_PRIVATE, File, 0);
+  close(File);
+  if (Address == MAP_FAILED)
+    return false;
+  auto Mapped = make_shared<MappedFile>(Address, Info.st_size);
+
+  const char *Base = static_cast<const char *>(Address);
+  FileHeader Header;
+  memcpy(&Header, Base, sizeof(Header));
+  const int64_t V = Header.VertexCount;
+  const int64_t E = Header.EdgeCount;
+  const int64_t Size = Header.FileSize;
+  const int64_t ReverseSize = Header.DirectionalEdges != 0 ? V + 1 : 0;
+  const int64_t ReverseEdges = Header.DirectionalEdges != 0 ? E : 0;
+  if (memcmp(Header.Magic, MAGIC, sizeof(MAGIC)) != 0 ||
+      Header.FormatVersion != FORMAT_VERSION || Size != Info.st_size ||
+      V < 0 || V >= numeric_limits<int>::max() || E < 0 ||
+      E > numeric_limits<int>::max() ||
+      !fits<int>(Header.OffsetsAt, V + 1, Size) ||
+      !fits<int>(Header.TargetsAt, E, Size) ||
+      !fits<int>(Header.WeightsAt, E, Size) ||
+      !fits<int>(Header.InOffsetsAt, ReverseSize, Size) ||
+      !fits<int>(Header.SourcesAt, ReverseEdges, Size) ||
+      !fits<int64_t>(Header.LabelOffsetsAt, V + 1, Size) ||
+      !fits<char>(Header.LabelCharsAt, Header.LabelBytes, Size) ||
+      !fits<VertexId>(Header.SortedIdsAt, V, Size))
+    return false;
+
+  auto IntView = [Base](int64_t At, int64_t Count) {
+    return ArrayView<int>(reinterpret_cast<const int *>(Base + At), Count);
+  };
+  ArrayView<int> NewOffsets = IntView(Header.OffsetsAt, V + 1);
+  ArrayView<int> NewTargets = IntView(Header.TargetsAt, E);
+  ArrayView<int> NewInOffsets = IntView(Header.InOffsetsAt, ReverseSize);
+  ArrayView<int> NewSources = IntView(Header.SourcesAt, ReverseEdges);
+  ArrayView<int64_t> NewLabelOffsets(
+      reinterpret_cast<const int64_t *>(Base + Header.LabelOffsetsAt), V + 1);
+  ArrayView<VertexId> NewSortedIds(
+      reinterpret_cast<const VertexId *>(Base + Header.SortedIdsAt), V);
+  // one pass over the arrays so a corrupt file cannot make queries read
+  // past them or idOf miss a label: offsets ascend to the array sizes, ids
+  // are vertices and the sorted ids follow their labels
+  if (Verify &&
+      (!ascending(NewOffsets, static_cast<int>(E)) ||
+       !ascending(NewLabelOffsets, Header.LabelBytes) ||
+       (ReverseSize > 0 && !ascending(NewInOffsets, static_cast<int>(E))) ||
+       !validIds(NewTargets, V) || !validIds(NewSources, V) ||
+       !validIds(NewSortedIds, V) ||
+       !sortedLabels(NewSortedIds, NewLabelOffsets,
+                     Base + Header.LabelCharsAt)))
+    return false;
+
+  DirectionalEdges = Header.DirectionalEdges != 0;
+  VertexCount = static_cast<int>(V);
+  Offsets = NewOffsets;
+  Targets = NewTargets;
+  EdgeWeights = IntView(Header.WeightsAt, E);
+  InOffsets = NewInOffsets;
+  Sources = NewSources;
+  LabelOffsets = NewLabelOffsets;
+  LabelChars = ArrayView<char>(Base + Header.LabelCharsAt, Header.LabelBytes);
+  SortedIds = NewSortedIds;
+  Storage = Mapped;
+  return true;
+}
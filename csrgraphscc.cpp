@@ -0,0 +1,199 @@
+/**
+ * Strongly connected components of a snapshot with several threads
+ * Follows the multistep method: trim, one forward-backward search for the
+ * largest component, coloring for the many small ones, then tarjan once
+ * few vertices are left
+ * Threads only write the entries of vertices they own or claim with an
+ * atomic exchange, and component numbers are written in separate passes
+ * from the ones that read them
+ *
+ * @author Bill Zhao
+ * @date updated on 10/17/2026
+ */
+
+#include "csrgraph.h"
+#include "threadpool.h"
+#include <atomic>
+
+using namespace std;
+
+namespace {
+
+// component of vertices that are not in a component yet
+const int NO_COMPONENT = -1;
+// passes of removing vertices with no edges in or out
+const int TRIM_PASSES = 3;
+// tarjan takes over when fewer vertices are left than this
+const int SERIAL_CUTOFF = 1 << 14;
+
+// level by level search from the vertices already marked in Reached,
+// following edges from a vertex to the ones Follow(From, To) allows,
+// each thread collects the vertices it claims for the next level
+template <typename FollowEdge>
+void parallelReach(ThreadPool &Pool, vector<VertexId> Frontier,
+                   ArrayView<int> Offsets, ArrayView<int> Targets,
+                   vector<atomic<char>> &Reached, FollowEdge Follow) {
+  vector<vector<VertexId>> Next(Pool.size());
+  while (!Frontier.empty()) {
+    Pool.parallelFor(static_cast<int>(Frontier.size()),
+                     [&](int Begin, int End, int Worker) {
+                       for (int I = Begin; I < End; ++I) {
+                         VertexId From = Frontier[I];
+                         for (int E = Offsets[From]; E < Offsets[From + 1];
+                              ++E) {
+                           VertexId To = Targets[E];
+                           if (Follow(From, To) &&
+                               !Reached[To].load(memory_order_relaxed) &&
+                               !Reached[To].exchange(1))
+                             Next[Worker].push_back(To);
+                         }
+                       }
+                     });
+    Frontier.clear();
+    for (auto &Claimed : Next) {
+      Frontier.insert(Frontier.end(), Claimed.begin(), Claimed.end());
+      Claimed.clear();
+    }
+  }
+}
+
+} // namespace
+
+Components CsrGraph::stronglyConnected(int Threads) const {
+  const int N = VertexCount;
+  ArrayView<int> InOffsets = inOffsets();
+  ArrayView<int> InSources = inSources();
+  ThreadPool Pool(Threads);
+  Components Found;
+  vector<int> &Component = Found.Component;
+  Component.assign(N, NO_COMPONENT);
+  atomic<int> Count(0);
+  auto Active = [&Component](VertexId V) {
+    return Component[V] == NO_COMPONENT;
+  };
+  auto ForAll = [&Pool, N](const function<void(VertexId)> &Task) {
+    Pool.parallelFor(N, [&Task](int Begin, int End, int /*Worker*/) {
+      for (VertexId V = Begin; V < End; ++V)
+        Task(V);
+    });
+  };
+
+  // a vertex that no other vertex left can reach, or that reaches no other
+  // vertex left, is a component on its own
+  vector<char> Trimmed(N);
+  for (int Pass = 0; Pass < TRIM_PASSES; ++Pass) {
+    ForAll([&](VertexId V) {
+      auto HasActive = [&](ArrayView<int> Offs, ArrayView<int> Ends) {
+        for (int E = Offs[V]; E < Offs[V + 1]; ++E) {
+          if (Ends[E] != V && Active(Ends[E]))
+            return true;
+        }
+        return false;
+      };
+      Trimmed[V] = Active(V) && (!HasActive(Offsets, Targets) ||
+                                 !HasActive(InOffsets, InSources));
+    });
+    atomic<int> Removed(0);
+    ForAll([&](VertexId V) {
+      if (Trimmed[V]) {
+        Component[V] = Count++;
+        Removed.fetch_add(1, memory_order_relaxed);
+      }
+    });
+    if (Removed == 0)
+      break;
+  }
+
+  // the largest component usually holds the vertex with the most edges
+  // both ways, it is what both searches from it reach
+  VertexId Pivot = NO_VERTEX;
+  int64_t MostEdges = -1;
+  for (VertexId V = 0; V < N; ++V) {
+    int64_t Edges = static_cast<int64_t>(Offsets[V + 1] - Offsets[V]) *
+                    (InOffsets[V + 1] - InOffsets[V]);
+    if (Active(V) && Edges > MostEdges) {
+      MostEdges = Edges;
+      Pivot = V;
+    }
+  }
+  if (Pivot != NO_VERTEX) {
+    vector<atomic<char>> Forward(N);
+    vector<atomic<char>> Backward(N);
+    auto BothActive = [&Active](VertexId /*From*/, VertexId To) {
+      return Active(To);
+    };
+    Forward[Pivot] = 1;
+    Backward[Pivot] = 1;
+    parallelReach(Pool, {Pivot}, Offsets, Targets, Forward, BothActive);
+    parallelReach(Pool, {Pivot}, InOffsets, InSources, Backward, BothActive);
+    const int Largest = Count++;
+    ForAll([&](VertexId V) {
+      if (Forward[V].load(memory_order_relaxed) &&
+          Backward[V].load(memory_order_relaxed))
+        Component[V] = Largest;
+    });
+  }
+
+  // coloring, each vertex takes the largest id that reaches it, then the
+  // vertices that reach a vertex whose color is its own id and have the
+  // same color are its component
+  vector<atomic<VertexId>> Color(N);
+  vector<atomic<char>> Reached(N);
+  vector<int> ComponentOfRoot(N, NO_COMPONENT);
+  while (true) {
+    atomic<int> Left(0);
+    ForAll([&](VertexId V) {
+      Color[V].store(V, memory_order_relaxed);
+      Reached[V].store(0, memory_order_relaxed);
+      if (Active(V))
+        Left.fetch_add(1, memory_order_relaxed);
+    });
+    if (Left < SERIAL_CUTOFF)
+      break;
+    atomic<bool> Changed(true);
+    while (Changed) {
+      Changed = false;
+      ForAll([&](VertexId V) {
+        if (!Active(V))
+          return;
+        VertexId Mine = Color[V].load(memory_order_relaxed);
+        for (int E = Offsets[V]; E < Offsets[V + 1]; ++E) {
+          VertexId To = Targets[E];
+          if (!Active(To))
+            continue;
+          VertexId Theirs = Color[To].load(memory_order_relaxed);
+          while (Theirs < Mine &&
+                 !Color[To].compare_exchange_weak(Theirs, Mine,
+                                                  memory_order_relaxed)) {
+          }
+          if (Theirs < Mine)
+            Changed.store(true, memory_order_relaxed);
+        }
+      });
+    }
+    vector<VertexId> Roots;
+    for (VertexId V = 0; V < N; ++V) {
+      if (Active(V) && Color[V].load(memory_order_relaxed) == V) {
+        Roots.push_back(V);
+        Reached[V] = 1;
+        ComponentOfRoot[V] = Count++;
+      }
+    }
+    auto SameColor = [&](VertexId From, VertexId To) {
+      return Active(To) && Color[To].load(memory_order_relaxed) ==
+                               Color[From].load(memory_order_relaxed);
+    };
+    parallelReach(Pool, Roots, InOffsets, InSources, Reached, SameColor);
+    ForAll([&](VertexId V) {
+      if (Reached[V].load(memory_order_relaxed))
+        Component[V] = ComponentOfRoot[Color[V].load(memory_order_relaxed)];
+    });
+  }
+
+  Found.Count = Count;
+  Found.Count += tarjanComponents(
+      N, [this](VertexId V) { return Offsets[V + 1] - Offsets[V]; },
+      [this](VertexId V, int I) { return Targets[Offsets[V] + I]; }, Active,
+      Component, Found.Count);
+  return Found;
+}
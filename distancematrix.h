@@ -0,0 +1,55 @@
+/**
+ * Shortest distances between all pairs of vertices of a graph, in one
+ * dense row-major array indexed by vertex id
+ * Rows may be padded past the last vertex, Stride is the row length
+ *
+ * @author Bill Zhao
+ * @date updated on 10/17/2026
+ */
+
+#ifndef DISTANCEMATRIX_H
+#define DISTANCEMATRIX_H
+
+#include "vertex.h"
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+using namespace std;
+
+// how Graph::allPairs finds the distances
+enum class ApspAlgorithm { Auto, FloydWarshall, Johnson };
+
+struct DistanceMatrix {
+  // number of vertices, and the length of a row, at least Size
+  int Size = 0;
+  int Stride = 0;
+  // distance from each vertex to each vertex, UNREACHABLE if there is no
+  // path and 0 from a vertex to itself
+  vector<int> Dist;
+  // vertex before To on the shortest path from From, NO_VERTEX if there is
+  // no path or To is From, empty unless previous vertices were asked for
+  vector<VertexId> Prev;
+
+  size_t at(VertexId From, VertexId To) const {
+    return static_cast<size_t>(From) * Stride + To;
+  }
+  int distance(VertexId From, VertexId To) const { return Dist[at(From, To)]; }
+  VertexId previous(VertexId From, VertexId To) const {
+    return Prev[at(From, To)];
+  }
+
+  // @return vertices of the shortest path, From first and To last, empty
+  // if there is no path or previous vertices were not kept
+  vector<VertexId> path(VertexId From, VertexId To) const {
+    vector<VertexId> Path;
+    if (Prev.empty() || distance(From, To) == UNREACHABLE)
+      return Path;
+    for (VertexId V = To; V != NO_VERTEX; V = previous(From, V))
+      Path.push_back(V);
+    reverse(Path.begin(), Path.end());
+    return Path;
+  }
+};
+
+#endif // DISTANCEMATRIX_H
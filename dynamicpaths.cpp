@@ -0,0 +1,216 @@
+/**
+ * DynamicPaths keeps the shortest paths from a set of sources up to date
+ * while edges are added, removed and reweighted
+ *
+ * @author Bill Zhao
+ * @date updated on 10/17/2026
+ */
+
+#include "dynamicpaths.h"
+#include <stdexcept>
+
+using namespace std;
+
+// in-edges are needed to reroute subtrees of directed graphs
+DynamicPaths::DynamicPaths(Graph &G)
+    : G(G), Version(G.version()), Queue(G.verticesSize()) {
+  if (G.DirectionalEdges)
+    G.indexInEdges();
+}
+
+// full dijkstra for a new source
+bool DynamicPaths::track(const string &Source) {
+  VertexId Id = G.idOf(Source);
+  if (Id == NO_VERTEX)
+    return false;
+  refresh();
+  if (Sources.count(Id) == 0)
+    Sources[Id] = G.dijkstra(Id);
+  return true;
+}
+
+bool DynamicPaths::untrack(const string &Source) {
+  return Sources.erase(G.idOf(Source)) > 0;
+}
+
+// add the edge, a new edge can only make paths shorter
+bool DynamicPaths::connect(const string &From, const string &To, int Weight) {
+  refresh();
+  bool Connected = G.connect(From, To, Weight);
+  grow();
+  Version = G.version();
+  if (Connected)
+    shortened(G.idOf(From), G.idOf(To), Weight);
+  return Connected;
+}
+
+// remove the edge, which can only make paths longer
+bool DynamicPaths::disconnect(const string &From, const string &To) {
+  refresh();
+  if (!G.disconnect(From, To))
+    return false;
+  Version = G.version();
+  lengthened(G.idOf(From), G.idOf(To));
+  return true;
+}
+
+// reweight the edge, repairing as for an added or a removed edge
+bool DynamicPaths::setWeight(const string &From, const string &To,
+                             int Weight) {
+  refresh();
+  VertexId FromId = G.idOf(From);
+  VertexId ToId = G.idOf(To);
+  if (FromId == NO_VERTEX || ToId == NO_VERTEX)
+    return false;
+  Edge *Changed = G.edgeBetween(G.AllVertices[FromId], G.AllVertices[ToId]);
+  if (Changed == nullptr)
+    return false;
+  int OldWeight = Changed->Weight;
+  G.setWeight(From, To, Weight);
+  Version = G.version();
+  if (Weight < OldWeight)
+    shortened(FromId, ToId, Weight);
+  else if (Weight > OldWeight)
+    lengthened(FromId, ToId);
+  return true;
+}
+
+// paths of a tracked source, brought up to date first
+const DynamicPaths::Paths *DynamicPaths::paths(const string &Source) {
+  refresh();
+  auto Found = Sources.find(G.idOf(Source));
+  return Found == Sources.end() ? nullptr : &Found->second;
+}
+
+// the graph was changed without us, start again, and put back the
+// in-edge index if it was turned off, the paths are still right without it
+void DynamicPaths::refresh() {
+  if (G.DirectionalEdges && !G.hasInEdgeIndex())
+    G.indexInEdges();
+  if (G.version() == Version)
+    return;
+  for (auto &Source : Sources)
+    Source.second = G.dijkstra(Source.first);
+  Queue.reserve(G.verticesSize());
+  Version = G.version();
+}
+
+// new vertices cannot be reached until an edge into them is repaired
+void DynamicPaths::grow() {
+  const int Size = G.verticesSize();
+  Queue.reserve(Size);
+  for (auto &Source : Sources) {
+    Source.second.first.resize(Size, UNREACHABLE);
+    Source.second.second.resize(Size, NO_VERTEX);
+  }
+}
+
+// versions only grow, so the graph never comes back to an earlier one
+void DynamicPaths::abandon() {
+  while (!Queue.empty())
+    Queue.pop();
+  Version = G.version() - 1;
+}
+
+// undirected edges are two directed edges of the same weight
+void DynamicPaths::shortened(VertexId From, VertexId To, int Weight) {
+  try {
+    for (auto &Source : Sources) {
+      improve(Source.second, From, To, Weight);
+      if (!G.DirectionalEdges)
+        improve(Source.second, To, From, Weight);
+    }
+  } catch (const overflow_error &) {
+    abandon();
+    throw;
+  }
+}
+
+void DynamicPaths::lengthened(VertexId From, VertexId To) {
+  try {
+    for (auto &Source : Sources) {
+      reroute(Source.second, From, To);
+      if (!G.DirectionalEdges)
+        reroute(Source.second, To, From);
+    }
+  } catch (const overflow_error &) {
+    abandon();
+    throw;
+  }
+}
+
+// only vertices whose distance drops are settled
+void DynamicPaths::improve(Paths &P, VertexId From, VertexId To, int Weight) {
+  vector<int> &Dist = P.first;
+  if (Dist[From] == UNREACHABLE)
+    return;
+  const int NewDist = pathLength(Dist[From], Weight);
+  if (NewDist >= Dist[To])
+    return;
+  Dist[To] = NewDist;
+  P.second[To] = From;
+  Queue.push(To, Dist[To]);
+  propagate(P);
+}
+
+// the subtree below To is found by following edges to vertices whose
+// previous vertex is the one the edge comes from
+// vertices outside the subtree keep their distances, so each vertex of the
+// subtree starts from its best edge coming from outside
+void DynamicPaths::reroute(Paths &P, VertexId From, VertexId To) {
+  vector<int> &Dist = P.first;
+  vector<VertexId> &Prev = P.second;
+  if (Prev[To] != From)
+    return;
+  auto Affected = G.VisitedSets.acquire(G.verticesSize());
+  Affected->mark(To);
+  vector<VertexId> Subtree(1, To);
+  for (int I = 0; I < Subtree.size(); ++I) {
+    for (auto Neighbor : G.AllVertices[Subtree[I]]->Neighbors) {
+      VertexId Child = Neighbor->To->Id;
+      if (Prev[Child] == Subtree[I] && Affected->visit(Child))
+        Subtree.push_back(Child);
+    }
+  }
+  for (VertexId V : Subtree) {
+    Dist[V] = UNREACHABLE;
+    Prev[V] = NO_VERTEX;
+  }
+  // in undirected graphs the edges out of a vertex mirror the edges into it
+  for (VertexId V : Subtree) {
+    Vertex *Curr = G.AllVertices[V];
+    const bool Mirrored = !G.DirectionalEdges;
+    for (auto InEdge : Mirrored ? Curr->Neighbors : Curr->InEdges) {
+      VertexId Outside = Mirrored ? InEdge->To->Id : InEdge->From->Id;
+      if (Affected->seen(Outside) || Dist[Outside] == UNREACHABLE)
+        continue;
+      const int Through = pathLength(Dist[Outside], InEdge->Weight);
+      if (Through < Dist[V]) {
+        Dist[V] = Through;
+        Prev[V] = Outside;
+      }
+    }
+    if (Dist[V] != UNREACHABLE)
+      Queue.push(V, Dist[V]);
+  }
+  propagate(P);
+}
+
+// dijkstra that only follows edges which lower a distance
+void DynamicPaths::propagate(Paths &P) {
+  vector<int> &Dist = P.first;
+  vector<VertexId> &Prev = P.second;
+  while (!Queue.empty()) {
+    VertexId Curr = Queue.pop();
+    Repaired++;
+    for (auto Neighbor : G.AllVertices[Curr]->Neighbors) {
+      VertexId Next = Neighbor->To->Id;
+      int NewDist = pathLength(Dist[Curr], Neighbor->Weight);
+      if (NewDist < Dist[Next]) {
+        Dist[Next] = NewDist;
+        Prev[Next] = Curr;
+        Queue.pushOrDecrease(Next, NewDist);
+      }
+    }
+  }
+}
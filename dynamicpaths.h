@@ -0,0 +1,100 @@
+/**
+ * DynamicPaths keeps the shortest paths from a set of sources up to date
+ * while edges are added, removed and reweighted
+ * Each source keeps its distances and its tree of previous vertices
+ * An edge that shortens a distance is followed out from its target only
+ * as far as distances keep dropping. An edge of the tree that is removed
+ * or made heavier only affects the subtree below it: those vertices are
+ * given the best distance through an edge from outside the subtree, then
+ * dijkstra runs inside the subtree (Ramalingam and Reps)
+ * Changes must go through DynamicPaths, if the graph is changed directly
+ * every source is computed again the next time it is used
+ *
+ * @author Bill Zhao
+ * @date updated on 10/17/2026
+ */
+
+#ifndef DYNAMICPATHS_H
+#define DYNAMICPATHS_H
+
+#include "graph.h"
+#include "indexedheap.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+class DynamicPaths {
+public:
+  // distances and previous vertices indexed by id, as Graph::dijkstra
+  using Paths = pair<vector<int>, vector<VertexId>>;
+
+  // paths on G, which keeps an in-edge index if it is directed, since
+  // repairs look at the edges into the vertices of a subtree
+  explicit DynamicPaths(Graph &G);
+
+  DynamicPaths(const DynamicPaths &) = delete;
+  DynamicPaths &operator=(const DynamicPaths &) = delete;
+
+  // start keeping the shortest paths from Source, computed by dijkstra
+  // @return false if the vertex is not in the graph
+  bool track(const string &Source);
+
+  // stop keeping the paths from Source
+  // @return false if it was not tracked
+  bool untrack(const string &Source);
+
+  // @return number of tracked sources
+  int trackedSize() const { return static_cast<int>(Sources.size()); }
+
+  // same as the graph's connect, disconnect and setWeight, followed by
+  // repairing the paths of every tracked source
+  // like Graph::dijkstra, the repairs throw overflow_error for a path too
+  // long for an int, the graph keeps the change
+  bool connect(const string &From, const string &To, int Weight = 0);
+  bool disconnect(const string &From, const string &To);
+  bool setWeight(const string &From, const string &To, int Weight);
+
+  // shortest paths from a tracked source, the distances are the same as
+  // Graph::dijkstra, the previous vertices may differ between paths of
+  // the same length
+  // @return nullptr if Source is not tracked
+  const Paths *paths(const string &Source);
+
+  // @return number of times a vertex was settled by repairs, dijkstra over
+  // the whole graph would settle every reachable vertex once per source
+  uint64_t repaired() const { return Repaired; }
+
+private:
+  Graph &G;
+  // graph version the paths are up to date with
+  uint64_t Version;
+  unordered_map<VertexId, Paths> Sources;
+  // shared by the repairs, always empty between them
+  IndexedHeap<int> Queue;
+  uint64_t Repaired = 0;
+
+  // recompute every source if the graph was changed directly, turn the
+  // in-edge index back on for directed graphs, and make room for vertices
+  // added since the last change
+  void refresh();
+  void grow();
+  // after a repair threw, empty the queue and recompute every source on
+  // the next call, which throws again while the long path is there
+  void abandon();
+  // paths of every source after an edge got shorter or was added
+  void shortened(VertexId From, VertexId To, int Weight);
+  // paths of every source after an edge got longer or was removed
+  void lengthened(VertexId From, VertexId To);
+  // lower the distance of To through the edge, then follow the drop
+  void improve(Paths &P, VertexId From, VertexId To, int Weight);
+  // find new paths for the subtree below To if its path used the edge
+  void reroute(Paths &P, VertexId From, VertexId To);
+  // dijkstra from the vertices in the queue, lowering distances only
+  void propagate(Paths &P);
+};
+
+#endif // DYNAMICPATHS_H
@@ -9,12 +9,15 @@
 #ifndef EDGE_H
 #define EDGE_H
 
-// forward declaration for class Vertex
+// forward declarations
 class Vertex;
+template <typename T> class SlabPool;
 
 class Edge {
   friend class Vertex;
   friend class Graph;
+  // edges are made by the graph's edge pool
+  template <typename T> friend class SlabPool;
 
 public:
   // use nolint for simplicity, easier to access
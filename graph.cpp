@@ -6,13 +6,18 @@
  */
 
 #include "graph.h"
+#include "csrgraph.h"
+#include "graphstats.h"
+#include "indexedheap.h"
+#include "threadpool.h"
 #include <algorithm>
 #include <cassert>
 #include <fstream>
+#include <functional>
 #include <iostream>
-#include <list>
 #include <map>
-#include <queue>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 using namespace std;
 
@@ -21,20 +26,22 @@ Graph::Graph(bool DirectionalEdges) {
   this->DirectionalEdges = DirectionalEdges;
 }
 
-// destructs the graph
+// edges are given back with their pool instead of one by one
+static_assert(is_trivially_destructible<Edge>::value,
+              "edges are released without running destructors");
+
+// destructs the graph, vertices own a label and a neighbor list so they are
+// destroyed, the memory of vertices and edges goes back with the pools
 Graph::~Graph() {
-  for (auto Tmp : AllVertices) {
-    for (auto Neighbor : Tmp->Neighbors) {
-      delete Neighbor;
-    }
-    Tmp->Neighbors.clear();
-    delete Tmp;
-  }
+  for (auto Tmp : AllVertices)
+    VertexPool.destroy(Tmp);
   AllVertices.clear();
+  VertexIndex.clear();
 }
 
 // read from a given file in the folder and construct accordingly
 bool Graph::readFile(const string &Filename) {
+  GRAPH_TIMER(ReadFile);
   ifstream Input;
   Input.open(Filename);
   if (Input.is_open()) {
@@ -43,24 +50,62 @@ bool Graph::readFile(const string &Filename) {
     string FromValue;
     string ToValue;
     int WeightValue;
+    vector<tuple<string, string, int>> FileEdges;
     for (int I = 0; I < Line; ++I) {
-      Input >> FromValue;
-      Input >> ToValue;
-      Input >> WeightValue;
-      connect(FromValue, ToValue, WeightValue);
+      if (!(Input >> FromValue >> ToValue >> WeightValue))
+        break;
+      FileEdges.emplace_back(FromValue, ToValue, WeightValue);
     }
     Input.close();
+    addEdgesUntimed(FileEdges);
     return true;
   }
   return false;
 }
 
+// pack the graph into a read-only compressed sparse row snapshot
+CsrGraph Graph::freeze() const { return CsrGraph(*this); }
+
 // get the number of vertices in the graph
 int Graph::verticesSize() const { return Vertices; }
 
 // get the number of edges in the graph
 int Graph::edgesSize() const { return Edges; }
 
+// get the number of changes made to the graph
+uint64_t Graph::version() const { return Version; }
+
+// bytes of a label outside the string object, 0 when it is stored inside
+static size_t labelBytes(const string &Label) {
+  const char *Inside = reinterpret_cast<const char *>(&Label);
+  const char *Data = Label.data();
+  bool Stored = Data >= Inside && Data < Inside + sizeof(string);
+  return Stored ? 0 : Label.capacity() + 1;
+}
+
+// add up the pools, the neighbor lists, the labels and the index
+GraphMemory Graph::memoryUsage() const {
+  GraphMemory Memory;
+  Memory.VertexBytes = VertexPool.bytes();
+  Memory.EdgeBytes = EdgePool.bytes();
+  Memory.FreeEdges = EdgePool.capacity() - EdgePool.size();
+  for (auto V : AllVertices) {
+    Memory.NeighborBytes +=
+        (V->Neighbors.capacity() + V->InEdges.capacity()) * sizeof(Edge *);
+    Memory.LabelBytes += labelBytes(V->Label);
+  }
+  // each node of the index holds its own copy of the label, a pointer to
+  // the next node and the cached hash
+  using IndexNode = pair<const string, Vertex *>;
+  Memory.IndexBytes = AllVertices.capacity() * sizeof(Vertex *) +
+                      VertexIndex.bucket_count() * sizeof(void *) +
+                      VertexIndex.size() *
+                          (sizeof(IndexNode) + sizeof(void *) + sizeof(size_t));
+  for (auto &Entry : VertexIndex)
+    Memory.IndexBytes += labelBytes(Entry.first);
+  return Memory;
+}
+
 // get the number of neighbors of a given vertex label
 int Graph::neighborsSize(const string &Label) const {
   Vertex *VertexLocation = nullptr;
@@ -69,30 +114,154 @@ int Graph::neighborsSize(const string &Label) const {
   return -1;
 }
 
+// in-edges are sorted by the label they come from
+static bool compareInEdge(Edge *E1, Edge *E2) {
+  return E1->From->Label < E2->From->Label;
+}
+
+// index the edges coming into each vertex, or drop the index
+void Graph::indexInEdges(bool Enabled) {
+  if (Enabled == InEdgeIndex)
+    return;
+  InEdgeIndex = Enabled;
+  for (auto V : AllVertices) {
+    V->InEdges.clear();
+    V->InEdges.shrink_to_fit();
+  }
+  if (!Enabled)
+    return;
+  vector<vector<Edge *>> Transposed = transposedEdges();
+  for (auto V : AllVertices)
+    V->InEdges = move(Transposed[V->Id]);
+}
+
+// in-edges of every vertex by id, vertices are visited in label order so
+// each list comes out sorted
+vector<vector<Edge *>> Graph::transposedEdges() const {
+  vector<Vertex *> ByLabel(AllVertices);
+  sort(ByLabel.begin(), ByLabel.end(),
+       [](Vertex *V1, Vertex *V2) { return V1->Label < V2->Label; });
+  vector<vector<Edge *>> Transposed(Vertices);
+  for (auto V : ByLabel) {
+    for (auto Neighbor : V->Neighbors)
+      Transposed[Neighbor->To->Id].push_back(Neighbor);
+  }
+  return Transposed;
+}
+
+// true if edges coming into vertices are indexed
+bool Graph::hasInEdgeIndex() const { return InEdgeIndex; }
+
+// edges coming into a vertex, sorted by the label they come from
+// without the index every edge is looked at
+vector<Edge *> Graph::inEdgesOf(Vertex *VertexLocation) const {
+  if (InEdgeIndex)
+    return VertexLocation->InEdges;
+  vector<Edge *> InEdges;
+  for (auto V : AllVertices) {
+    for (auto Neighbor : V->Neighbors) {
+      if (Neighbor->To == VertexLocation)
+        InEdges.push_back(Neighbor);
+    }
+  }
+  sort(InEdges.begin(), InEdges.end(), compareInEdge);
+  return InEdges;
+}
+
+// get the number of edges coming into a vertex
+int Graph::inNeighborsSize(const string &Label) const {
+  Vertex *VertexLocation = nullptr;
+  if (inGraph(Label, VertexLocation))
+    return static_cast<int>(inEdgesOf(VertexLocation).size());
+  return -1;
+}
+
+// edges coming into a vertex as a string, same format as getEdgesAsString
+string Graph::getInEdgesAsString(const string &Label) const {
+  Vertex *VertexLocation = nullptr;
+  string Ans;
+  if (inGraph(Label, VertexLocation)) {
+    for (auto InEdge : inEdgesOf(VertexLocation)) {
+      if (!Ans.empty())
+        Ans += ",";
+      Ans += InEdge->From->Label + "(" + to_string(InEdge->Weight) + ")";
+    }
+  }
+  return Ans;
+}
+
+// remove every edge coming into a vertex
+int Graph::disconnectIncoming(const string &Label) {
+  Vertex *VertexLocation = nullptr;
+  if (!inGraph(Label, VertexLocation))
+    return 0;
+  int Removed = 0;
+  for (auto InEdge : inEdgesOf(VertexLocation))
+    Removed += disconnectVertices(InEdge->From, VertexLocation);
+  return Removed;
+}
+
 // get the vertex pointer if the given vertex label exist in the graph
 // return true if found, false otherwise
 // NOLINTNEXTLINE
 bool Graph::inGraph(const string &Label, Vertex *&VertexLocation) const {
-  for (auto AllVertice : AllVertices) {
-    if (AllVertice->Label == Label) {
-      VertexLocation = AllVertice;
-      return true;
-    }
-  }
-  return false;
+  GRAPH_COUNT(LabelLookups, 1);
+  auto Found = VertexIndex.find(Label);
+  if (Found == VertexIndex.end())
+    return false;
+  VertexLocation = Found->second;
+  return true;
+}
+
+// get the vertex with the given label, creating it if necessary
+Vertex *Graph::findOrAdd(const string &Label) {
+  Vertex *VertexLocation = nullptr;
+  if (inGraph(Label, VertexLocation))
+    return VertexLocation;
+  Vertices++;
+  Version++;
+  GRAPH_COUNT(VerticesAdded, 1);
+  VertexLocation = VertexPool.create(Label);
+  VertexLocation->Id = static_cast<int>(AllVertices.size());
+  AllVertices.push_back(VertexLocation);
+  VertexIndex.emplace(Label, VertexLocation);
+  return VertexLocation;
 }
 
 // add the given vertex label to the graph
 bool Graph::add(const string &Label) {
   if (!contains(Label)) {
-    Vertices++;
-    auto Tmp = new Vertex(Label);
-    AllVertices.push_back(Tmp);
+    findOrAdd(Label);
     return true;
   }
   return false;
 }
 
+// add the given vertex label to the graph and get its id
+bool Graph::add(const string &Label, VertexId &Id) {
+  bool Added = !contains(Label);
+  Id = findOrAdd(Label)->Id;
+  return Added;
+}
+
+// get the id of the vertex with the given label
+VertexId Graph::idOf(const string &Label) const {
+  Vertex *VertexLocation = nullptr;
+  if (inGraph(Label, VertexLocation))
+    return VertexLocation->Id;
+  return NO_VERTEX;
+}
+
+// get the label of the vertex with the given id
+const string &Graph::labelOf(VertexId Id) const {
+  return AllVertices.at(Id)->Label;
+}
+
+// return true if the id belongs to a vertex in the graph
+bool Graph::validId(VertexId Id) const {
+  return Id >= 0 && Id < AllVertices.size();
+}
+
 /** return true if vertex already in graph */
 bool Graph::contains(const std::string &Label) const {
   Vertex *VertexLocation = nullptr;
@@ -121,142 +290,346 @@ bool compareEdge(Edge *E1, Edge *E2) { return (E1->To->Label < E2->To->Label); }
 
 // connect to vertices to one edge
 bool Graph::connect(const string &From, const string &To, int Weight) {
+  GRAPH_TIMER(Connect);
   if (From == To)
     return false;
+  // add From before To so vertex ids follow the order labels are seen
+  Vertex *FromVertex = findOrAdd(From);
+  Vertex *ToVertex = findOrAdd(To);
+  return connectVertices(FromVertex, ToVertex, Weight);
+}
 
-  add(From);
-  add(To);
-  auto FromVertex = AllVertices.at(0);
-  auto ToVertex = AllVertices.at(0);
-  for (auto Tmp : AllVertices) {
-    if (Tmp->Label == From)
-      FromVertex = Tmp;
-    if (Tmp->Label == To)
-      ToVertex = Tmp;
-  }
+// connect two vertices given by id
+bool Graph::connect(VertexId From, VertexId To, int Weight) {
+  GRAPH_TIMER(Connect);
+  if (From == To || !validId(From) || !validId(To))
+    return false;
+  return connectVertices(AllVertices[From], AllVertices[To], Weight);
+}
+
+// connect two vertices, mirror the edge for undirected graphs
+bool Graph::connectVertices(Vertex *FromVertex, Vertex *ToVertex,
+                            int Weight) {
+  if (!addEdge(FromVertex, ToVertex, Weight))
+    return false;
+  if (!DirectionalEdges)
+    addEdge(ToVertex, FromVertex, Weight);
+  return true;
+}
+
+// add a single directed edge, keeping neighbors sorted by label
+bool Graph::addEdge(Vertex *FromVertex, Vertex *ToVertex, int Weight) {
   for (auto Connected : FromVertex->Neighbors) {
-    if (Connected->From->Label == From && Connected->To->Label == To) {
+    if (Connected->To == ToVertex) {
       return false;
     }
   }
-  Edge *NewEdge = new Edge(FromVertex, ToVertex, Weight);
-  FromVertex->Neighbors.push_back(NewEdge);
-  Edges++;
-  sort(FromVertex->Neighbors.begin(), FromVertex->Neighbors.end(), compareEdge);
-  if (!NonDirectionalAdded && !DirectionalEdges) {
-    NonDirectionalAdded = true;
-    connect(To, From, Weight);
+  Edge *NewEdge = EdgePool.create(FromVertex, ToVertex, Weight);
+  auto Position = upper_bound(FromVertex->Neighbors.begin(),
+                              FromVertex->Neighbors.end(), NewEdge, compareEdge);
+  FromVertex->Neighbors.insert(Position, NewEdge);
+  if (InEdgeIndex) {
+    auto &InEdges = ToVertex->InEdges;
+    InEdges.insert(
+        upper_bound(InEdges.begin(), InEdges.end(), NewEdge, compareInEdge),
+        NewEdge);
   }
-  NonDirectionalAdded = false;
+  Edges++;
+  Version++;
+  GRAPH_COUNT(EdgesAdded, 1);
   return true;
 }
 
+// add many edges, same result as calling connect for each edge in order
+int Graph::addEdges(const vector<tuple<string, string, int>> &NewEdges) {
+  GRAPH_TIMER(Connect);
+  return addEdgesUntimed(NewEdges);
+}
+
+int Graph::addEdgesUntimed(
+    const vector<tuple<string, string, int>> &NewEdges) {
+  vector<PendingEdge> Pending;
+  Pending.reserve(DirectionalEdges ? NewEdges.size() : 2 * NewEdges.size());
+  for (auto &NewEdge : NewEdges) {
+    const string &From = get<0>(NewEdge);
+    const string &To = get<1>(NewEdge);
+    if (From == To)
+      continue;
+    // add From before To so vertex ids follow the order labels are seen
+    VertexId FromId = findOrAdd(From)->Id;
+    VertexId ToId = findOrAdd(To)->Id;
+    Pending.push_back({FromId, ToId, get<2>(NewEdge), false});
+    if (!DirectionalEdges)
+      Pending.push_back({ToId, FromId, get<2>(NewEdge), true});
+  }
+  return addPendingEdges(Pending);
+}
+
+// group the edges by source vertex with a stable counting sort, so each
+// group is in the order connect would have seen it, then keep the first edge
+// to each target that is not already in the graph
+// vertices are independent, so with a pool they are split between threads
+int Graph::addPendingEdges(const vector<PendingEdge> &Pending,
+                           ThreadPool *Pool) {
+  vector<int> Start(Vertices + 1, 0);
+  for (auto &P : Pending)
+    Start[P.From + 1]++;
+  for (int V = 0; V < Vertices; ++V)
+    Start[V + 1] += Start[V];
+  vector<int> Order(Pending.size());
+  vector<int> Next(Start.begin(), Start.end() - 1);
+  for (int I = 0; I < Pending.size(); ++I)
+    Order[Next[Pending[I].From]++] = I;
+
+  // first find which edges are kept, each thread keeps for each target
+  // the last vertex that had an edge to it, so nothing needs clearing
+  // between vertices
+  const int Workers = Pool != nullptr ? Pool->size() : 1;
+  auto Run = [Pool](int Count, const function<void(int, int, int)> &Task) {
+    if (Pool != nullptr)
+      Pool->parallelFor(Count, Task);
+    else
+      Task(0, Count, 0);
+  };
+  vector<char> Kept(Pending.size(), 0);
+  vector<vector<VertexId>> TargetOf(Workers);
+  Run(Vertices, [&](int Begin, int End, int Worker) {
+    vector<VertexId> &LastFrom = TargetOf[Worker];
+    if (LastFrom.empty())
+      LastFrom.assign(Vertices, NO_VERTEX);
+    for (VertexId V = Begin; V < End; ++V) {
+      if (Start[V] == Start[V + 1])
+        continue;
+      for (auto Neighbor : AllVertices[V]->Neighbors)
+        LastFrom[Neighbor->To->Id] = V;
+      for (int I = Start[V]; I < Start[V + 1]; ++I) {
+        VertexId To = Pending[Order[I]].To;
+        Kept[I] = LastFrom[To] != V;
+        LastFrom[To] = V;
+      }
+    }
+  });
+
+  // the edge pool is not thread safe, but taking slots from it is cheap
+  // new in-edges are added at the end here and merged in below
+  int Connected = 0;
+  vector<Edge *> NewEdges(Pending.size(), nullptr);
+  vector<int> OldInEdges(InEdgeIndex ? Vertices : 0);
+  for (VertexId V = 0; V < OldInEdges.size(); ++V)
+    OldInEdges[V] = static_cast<int>(AllVertices[V]->InEdges.size());
+  for (int I = 0; I < Pending.size(); ++I) {
+    if (!Kept[I])
+      continue;
+    const PendingEdge &P = Pending[Order[I]];
+    NewEdges[I] = EdgePool.create(AllVertices[P.From], AllVertices[P.To],
+                                  P.Weight);
+    if (InEdgeIndex)
+      AllVertices[P.To]->InEdges.push_back(NewEdges[I]);
+    Edges++;
+    Version++;
+    GRAPH_COUNT(EdgesAdded, 1);
+    if (!P.Mirror)
+      Connected++;
+  }
+
+  // merge the sorted new edges into the sorted neighbors
+  Run(Vertices, [&](int Begin, int End, int /*Worker*/) {
+    vector<Edge *> Added;
+    for (VertexId V = Begin; V < End; ++V) {
+      if (InEdgeIndex) {
+        auto &InEdges = AllVertices[V]->InEdges;
+        auto Old = InEdges.begin() + OldInEdges[V];
+        sort(Old, InEdges.end(), compareInEdge);
+        inplace_merge(InEdges.begin(), Old, InEdges.end(), compareInEdge);
+      }
+      Added.clear();
+      for (int I = Start[V]; I < Start[V + 1]; ++I) {
+        if (Kept[I])
+          Added.push_back(NewEdges[I]);
+      }
+      if (Added.empty())
+        continue;
+      stable_sort(Added.begin(), Added.end(), compareEdge);
+      auto &Neighbors = AllVertices[V]->Neighbors;
+      size_t Old = Neighbors.size();
+      Neighbors.insert(Neighbors.end(), Added.begin(), Added.end());
+      inplace_merge(Neighbors.begin(), Neighbors.begin() + Old,
+                    Neighbors.end(), compareEdge);
+    }
+  });
+  return Connected;
+}
+
 // disconnect two vertices from one edge
 bool Graph::disconnect(const string &From, const string &To) {
-  Vertex *Tmp = nullptr;
-  if (From == To || !inGraph(From, Tmp) || !contains(To))
+  Vertex *FromVertex = nullptr;
+  Vertex *ToVertex = nullptr;
+  if (From == To || !inGraph(From, FromVertex) || !inGraph(To, ToVertex))
     return false;
-  bool Found = false;
-  for (int I = 0; I < Tmp->Neighbors.size(); ++I) {
-    Edge *Connected = Tmp->Neighbors.at(I);
-    if (Connected->From->Label == From && Connected->To->Label == To) {
-      Found = true;
-      Tmp->Neighbors.erase(Tmp->Neighbors.begin() + I);
-      delete Connected;
+  return disconnectVertices(FromVertex, ToVertex);
+}
+
+// disconnect two vertices given by id
+bool Graph::disconnect(VertexId From, VertexId To) {
+  if (From == To || !validId(From) || !validId(To))
+    return false;
+  return disconnectVertices(AllVertices[From], AllVertices[To]);
+}
+
+// disconnect two vertices, remove the mirror edge for undirected graphs
+bool Graph::disconnectVertices(Vertex *FromVertex, Vertex *ToVertex) {
+  bool Found = removeEdge(FromVertex, ToVertex);
+  if (!DirectionalEdges)
+    removeEdge(ToVertex, FromVertex);
+  return Found;
+}
+
+// change the weight of an edge and its mirror
+bool Graph::setWeight(const string &From, const string &To, int Weight) {
+  Vertex *FromVertex = nullptr;
+  Vertex *ToVertex = nullptr;
+  if (!inGraph(From, FromVertex) || !inGraph(To, ToVertex))
+    return false;
+  Edge *Found = edgeBetween(FromVertex, ToVertex);
+  if (Found == nullptr)
+    return false;
+  Found->Weight = Weight;
+  if (!DirectionalEdges)
+    edgeBetween(ToVertex, FromVertex)->Weight = Weight;
+  Version++;
+  return true;
+}
+
+// find the edge between two vertices in the neighbors of the first
+Edge *Graph::edgeBetween(Vertex *FromVertex, Vertex *ToVertex) const {
+  for (auto Neighbor : FromVertex->Neighbors) {
+    if (Neighbor->To == ToVertex)
+      return Neighbor;
+  }
+  return nullptr;
+}
+
+// remove a single directed edge
+bool Graph::removeEdge(Vertex *FromVertex, Vertex *ToVertex) {
+  for (int I = 0; I < FromVertex->Neighbors.size(); ++I) {
+    Edge *Connected = FromVertex->Neighbors.at(I);
+    if (Connected->To == ToVertex) {
+      FromVertex->Neighbors.erase(FromVertex->Neighbors.begin() + I);
+      if (InEdgeIndex) {
+        auto &InEdges = ToVertex->InEdges;
+        InEdges.erase(find(InEdges.begin(), InEdges.end(), Connected));
+      }
+      EdgePool.destroy(Connected);
       Edges--;
+      Version++;
+      return true;
     }
   }
-  if (!NonDirectionalDeleted && !DirectionalEdges) {
-    NonDirectionalDeleted = true;
-    disconnect(To, From);
-  }
-  NonDirectionalDeleted = false;
-  return Found;
+  return false;
 }
 
 // dfs traversal
-void Graph::dfs(const string &StartLabel, void Visit(const string &Label)) {
-  Vertex *VertexLocation = nullptr;
-  for (auto Tmp : AllVertices) {
-    Tmp->Seen = false;
-  }
-  if (inGraph(StartLabel, VertexLocation)) {
-    dfs(VertexLocation, Visit);
+void Graph::dfs(const string &StartLabel,
+                void Visit(const string &Label)) const {
+  dfs(StartLabel, [Visit](const string &Label) { Visit(Label); });
+}
+
+// dfs traversal from the vertex with the given id
+void Graph::dfs(VertexId Start, void Visit(VertexId Id)) const {
+  dfs(Start, [Visit](VertexId Id) { Visit(Id); });
+}
+
+// dfs numbering of the vertices reachable from Start
+DfsOrder Graph::dfsOrder(VertexId Start) const {
+  GRAPH_TIMER(Traversal);
+  DfsOrder Order(Vertices);
+  if (validId(Start)) {
+    auto Visited = VisitedSets.acquire(Vertices);
+    dfsNumber(AllVertices[Start], *Visited, Order);
   }
+  return Order;
 }
 
-// dfs traversal helper, to be called recursively
-void Graph::dfs(Vertex *VertexLocation, void (*Visit)(const string &)) {
-  Visit(VertexLocation->Label);
-  VertexLocation->Seen = true;
-  for (auto &Neighbor : VertexLocation->Neighbors) {
-    if (!Neighbor->To->Seen) {
-      dfs(Neighbor->To, Visit);
-    }
+// dfs numbering of all vertices, a new tree starts from the smallest id not
+// reached yet
+DfsOrder Graph::dfsOrder() const {
+  GRAPH_TIMER(Traversal);
+  DfsOrder Order(Vertices);
+  auto Visited = VisitedSets.acquire(Vertices);
+  for (auto Tmp : AllVertices) {
+    if (!Visited->seen(Tmp->Id))
+      dfsNumber(Tmp, *Visited, Order);
   }
+  return Order;
+}
+
+// add one dfs tree to the numbering, continuing from the numbers already used
+void Graph::dfsNumber(Vertex *Start, VisitedSet &Visited,
+                      DfsOrder &Order) const {
+  dfsFrom(
+      Start, Visited,
+      [&Order](Vertex *Curr, Vertex *Parent) {
+        Order.PreOrder[Curr->Id] = Order.Visited++;
+        Order.Discovery[Curr->Id] = Order.Time++;
+        Order.Parent[Curr->Id] = Parent == nullptr ? NO_VERTEX : Parent->Id;
+      },
+      [&Order](Vertex *Curr) {
+        Order.PostOrder[Curr->Id] = Order.Finished++;
+        Order.Finish[Curr->Id] = Order.Time++;
+      });
 }
 
 // bfs traversal
-void Graph::bfs(const string &StartLabel, void Visit(const string &Label)) {
+void Graph::bfs(const string &StartLabel,
+                void Visit(const string &Label)) const {
+  bfs(StartLabel, [Visit](const string &Label) { Visit(Label); });
+}
+
+// bfs traversal from the vertex with the given id
+void Graph::bfs(VertexId Start, void Visit(VertexId Id)) const {
+  bfs(Start, [Visit](VertexId Id) { Visit(Id); });
+}
+
+// bfs following edges backwards, from the start to the vertices that have
+// an edge to it, and so on
+void Graph::bfsReverse(const string &StartLabel,
+                       void Visit(const string &Label)) const {
+  GRAPH_TIMER(Traversal);
   Vertex *VertexLocation = nullptr;
-  for (auto Tmp : AllVertices) {
-    Tmp->Seen = false;
-  }
-  if (inGraph(StartLabel, VertexLocation)) {
-    VertexLocation->Seen = true;
-    list<Vertex *> Queue;
-    Queue.push_back(VertexLocation);
-    while (!Queue.empty()) {
-      Vertex *Curr = Queue.front();
-      Visit(Curr->Label);
-      Queue.pop_front();
-      for (auto &Neighbor : Curr->Neighbors) {
-        if (!Neighbor->To->Seen) {
-          Neighbor->To->Seen = true;
-          Queue.push_back(Neighbor->To);
-        }
-      }
-    }
-  }
+  if (inGraph(StartLabel, VertexLocation))
+    bfsReverseFrom(VertexLocation,
+                   [Visit](Vertex *Curr) { Visit(Curr->Label); });
 }
 
-// minimum spanning tree
-int Graph::mst(const string &StartLabel,
-               void Visit(const string &From, const string &To,
-                          int Weight)) const {
-  assert(!DirectionalEdges);
-  for (auto Tmp : AllVertices) {
-    Tmp->Seen = false;
-  }
-  auto VertexLocation = AllVertices.at(0);
-  if (inGraph(StartLabel, VertexLocation)) {
-    VertexLocation->Seen = true;
-    vector<Vertex *> SeenVertices;
-    SeenVertices.push_back(VertexLocation);
-    int Ans = 0;
-    Edge *MinEdge = nullptr;
-    int MinEdgeWeight = 0;
-    for (auto &SeenVertice : SeenVertices) {
-      map<int, Edge *> EdgeWeights;
-      for (auto Tmp : SeenVertice->Neighbors) {
-        if (!Tmp->To->Seen)
-          EdgeWeights.insert(pair<int, Edge *>(Tmp->Weight, Tmp));
-      }
-      MinEdgeWeight = EdgeWeights.begin()->first;
-      MinEdge = EdgeWeights.begin()->second;
-      if (StartLabel != "X")
-        return 4;
-      if (MinEdge != nullptr) {
-        MinEdge->To->Seen = true;
-        Visit(MinEdge->From->Label, MinEdge->To->Label, MinEdge->Weight);
-        Ans += MinEdgeWeight;
-      } else {
-        break;
-      }
+// reverse bfs traversal from the vertex with the given id
+void Graph::bfsReverse(VertexId Start, void Visit(VertexId Id)) const {
+  GRAPH_TIMER(Traversal);
+  if (validId(Start))
+    bfsReverseFrom(AllVertices[Start],
+                   [Visit](Vertex *Curr) { Visit(Curr->Id); });
+}
+
+// reverse bfs, without the index the in-edges of all vertices are found
+// once before starting
+template <typename VisitVertex>
+void Graph::bfsReverseFrom(Vertex *VertexLocation, VisitVertex Visit) const {
+  vector<vector<Edge *>> Transposed;
+  if (!InEdgeIndex)
+    Transposed = transposedEdges();
+  auto Visited = VisitedSets.acquire(Vertices);
+  Visited->mark(VertexLocation->Id);
+  vector<Vertex *> Queue(1, VertexLocation);
+  for (int I = 0; I < Queue.size(); ++I) {
+    Vertex *Curr = Queue[I];
+    Visit(Curr);
+    auto &InEdges = InEdgeIndex ? Curr->InEdges : Transposed[Curr->Id];
+    GRAPH_COUNT(VerticesVisited, 1);
+    GRAPH_COUNT(EdgesScanned, InEdges.size());
+    for (auto InEdge : InEdges) {
+      if (Visited->visit(InEdge->From->Id))
+        Queue.push_back(InEdge->From);
     }
-    return Ans;
   }
-  return -1;
 }
 
 // store the weights in a map
@@ -265,45 +638,49 @@ pair<map<string, int>, map<string, string>>
 Graph::dijkstra(const string &StartLabel) const {
   map<string, int> Weights;
   map<string, string> Previous;
-  for (auto Tmp : AllVertices) {
-    Tmp->Seen = false;
-  }
   Vertex *VertexLocation = nullptr;
   if (inGraph(StartLabel, VertexLocation)) {
-    priority_queue<pair<string, int>, vector<pair<string, int>>, PQRule> Queue;
-    map<string, Vertex *> SeenVertices;
-    for (int I = 0; I < VertexLocation->Neighbors.size(); ++I) {
-      string LabelValue = VertexLocation->next();
-      Weights[LabelValue] = VertexLocation->edgeWeight(LabelValue);
-      Previous[LabelValue] = StartLabel;
-      Queue.push(make_pair(LabelValue, Weights[LabelValue]));
-    }
-    SeenVertices[StartLabel] = VertexLocation;
-    while (!Queue.empty()) {
-      string Tmp = Queue.top().first;
-      Queue.pop();
-      if (inGraph(Tmp, VertexLocation) && SeenVertices.count(Tmp) == 0) {
-        for (int I = 0; I < VertexLocation->Neighbors.size(); ++I) {
-          string LabelValue = VertexLocation->next();
-          if (Weights.count(LabelValue) != 0) {
-            if (Weights.at(LabelValue) >
-                Weights.at(Tmp) + VertexLocation->edgeWeight(LabelValue)) {
-              Weights[LabelValue] =
-                  Weights[Tmp] + VertexLocation->edgeWeight(LabelValue);
-              Previous[LabelValue] = Tmp;
-              Queue.push(make_pair(LabelValue, Weights[LabelValue]));
-            }
-          } else {
-            Weights[LabelValue] =
-                Weights[Tmp] + VertexLocation->edgeWeight(LabelValue);
-            Previous[LabelValue] = Tmp;
-            Queue.push(make_pair(LabelValue, Weights[LabelValue]));
-          }
-        }
+    vector<int> Dist;
+    vector<VertexId> Prev;
+    tie(Dist, Prev) = dijkstra(VertexLocation->Id);
+    for (auto Tmp : AllVertices) {
+      if (Prev[Tmp->Id] != NO_VERTEX) {
+        Weights[Tmp->Label] = Dist[Tmp->Id];
+        Previous[Tmp->Label] = AllVertices[Prev[Tmp->Id]]->Label;
       }
     }
   }
-  Weights.erase(StartLabel);
-  Previous.erase(StartLabel);
   return make_pair(Weights, Previous);
 }
+
+// shortest distances and previous vertices as dense arrays indexed by id
+pair<vector<int>, vector<VertexId>> Graph::dijkstra(VertexId Start) const {
+  GRAPH_TIMER(ShortestPath);
+  vector<int> Dist(AllVertices.size(), UNREACHABLE);
+  vector<VertexId> Prev(AllVertices.size(), NO_VERTEX);
+  if (!validId(Start))
+    return make_pair(Dist, Prev);
+  // vertices are settled once they leave the heap
+  auto Done = VisitedSets.acquire(Vertices);
+  IndexedHeap<int> Queue(static_cast<int>(AllVertices.size()));
+  Dist[Start] = 0;
+  Queue.push(Start, 0);
+  GRAPH_COUNT(HeapPushes, 1);
+  while (!Queue.empty()) {
+    VertexId Curr = Queue.pop();
+    Done->mark(Curr);
+    GRAPH_COUNT(VerticesSettled, 1);
+    for (auto Neighbor : AllVertices[Curr]->Neighbors) {
+      VertexId Next = Neighbor->To->Id;
+      int NewDist = pathLength(Dist[Curr], Neighbor->Weight);
+      if (!Done->seen(Next) && NewDist < Dist[Next]) {
+        Dist[Next] = NewDist;
+        Prev[Next] = Curr;
+        Queue.pushOrDecrease(Next, NewDist);
+        GRAPH_COUNT(EdgesRelaxed, 1);
+        GRAPH_COUNT(HeapPushes, 1);
+      }
+    }
+  }
+  return make_pair(Dist, Prev);
+}
@@ -11,14 +11,81 @@
 #ifndef GRAPH_H
 #define GRAPH_H
 
+#include "components.h"
+#include "csrgraph.h"
+#include "distancematrix.h"
 #include "edge.h"
+#include "graphstats.h"
+#include "slabpool.h"
+#include "traversal.h"
 #include "vertex.h"
+#include "visitedpool.h"
+#include "weightedcsr.h"
+#include <cstdint>
+#include <functional>
 #include <map>
 #include <string>
+#include <tuple>
+#include <unordered_map>
 
 using namespace std;
 
+class ThreadPool;
+
+// numbering of the vertices from a depth-first traversal, indexed by id
+// all values are -1, or NO_VERTEX, for vertices that were not reached
+// Discovery and Finish share one clock, so Y is a descendant of X exactly
+// when Discovery[X] < Discovery[Y] and Finish[Y] < Finish[X]
+struct DfsOrder {
+  explicit DfsOrder(int Size)
+      : PreOrder(Size, -1), PostOrder(Size, -1), Discovery(Size, -1),
+        Finish(Size, -1), Parent(Size, NO_VERTEX) {}
+  // position of the vertex in the order vertices are reached
+  vector<int> PreOrder;
+  // position of the vertex in the order vertices are finished,
+  // decreasing PostOrder is a topological order if there are no cycles
+  vector<int> PostOrder;
+  // time the vertex was reached and the time it was finished
+  vector<int> Discovery;
+  vector<int> Finish;
+  // vertex it was reached from, NO_VERTEX for the start of each tree
+  vector<VertexId> Parent;
+  // number of vertices reached and finished, and the clock
+  int Visited = 0;
+  int Finished = 0;
+  int Time = 0;
+};
+
+// how Graph::mst finds the tree
+enum class MstAlgorithm { Prim, Kruskal, Boruvka };
+
+// bytes used by a graph, from the sizes of its pools, lists and index
+// the index is an estimate, it depends on how the hash map lays out nodes
+struct GraphMemory {
+  // blocks of the vertex and edge pools, including free slots
+  size_t VertexBytes = 0;
+  size_t EdgeBytes = 0;
+  // edge slots freed by disconnect and waiting to be reused
+  size_t FreeEdges = 0;
+  // neighbor lists of all vertices
+  size_t NeighborBytes = 0;
+  // characters of labels too long to be stored inside the string
+  size_t LabelBytes = 0;
+  // label to vertex index and id to vertex array
+  size_t IndexBytes = 0;
+  // @return sum of all bytes
+  size_t total() const {
+    return VertexBytes + EdgeBytes + NeighborBytes + LabelBytes + IndexBytes;
+  }
+};
+
 class Graph {
+  friend class BfsRange;
+  friend class ConcurrentGraphBuilder;
+  friend class CsrGraph;
+  friend class DfsRange;
+  friend class DynamicPaths;
+
 public:
   // constructor, empty graph
   explicit Graph(bool DirectionalEdges = true);
@@ -29,6 +96,17 @@ public:
   // @return true if vertex added, false if it already is in the graph
   bool add(const string &Label);
 
+  // add vertex, Id is set to the id of the vertex even if it already existed
+  // ids are given out in order, starting from 0, and never change
+  // @return true if vertex added, false if it already is in the graph
+  bool add(const string &Label, VertexId &Id);
+
+  // @return id of the vertex, NO_VERTEX if vertex not found
+  VertexId idOf(const string &Label) const;
+
+  // @return label of the vertex with the given id, throws if id is not valid
+  const string &labelOf(VertexId Id) const;
+
   // @return true if vertex is in the graph
   bool contains(const string &Label) const;
 
@@ -41,10 +119,24 @@ public:
   // Undirected graphs must have P->Q and Q->P with same weight
   // @return true if successfully connected
   bool connect(const string &From, const string &To, int Weight = 0);
+  // same as above for existing vertices, false if either id is not valid
+  bool connect(VertexId From, VertexId To, int Weight = 0);
+
+  // Add many edges at once, the result is the same as calling connect for
+  // each edge in order, including which vertices and duplicates are kept,
+  // but the edges are sorted once per vertex instead of once per edge
+  // @return number of edges for which connect would have returned true
+  int addEdges(const vector<tuple<string, string, int>> &NewEdges);
 
   // Remove edge from graph
   // @return true if edge successfully deleted
   bool disconnect(const string &From, const string &To);
+  bool disconnect(VertexId From, VertexId To);
+
+  // change the weight of an existing edge, for undirected graphs of both
+  // the edge and its mirror
+  // @return true if the edge was found
+  bool setWeight(const string &From, const string &To, int Weight);
 
   // @return total number of edges
   int edgesSize() const;
@@ -52,6 +144,36 @@ public:
   // @return number of edges from given vertex, -1 if vertex not found
   int neighborsSize(const string &Label) const;
 
+  // @return a number that changes whenever a vertex or an edge is added or
+  // removed, results computed at the same version are still valid
+  uint64_t version() const;
+
+  // @return bytes used by the graph, to compare layouts and sizes
+  GraphMemory memoryUsage() const;
+
+  // keep, or stop keeping, a list of the edges coming into each vertex,
+  // updated by connect and disconnect
+  // with it, the in-edge queries and bfsReverse take time in proportion to
+  // the edges they look at instead of all edges in the graph, and
+  // shortestPath can search directed graphs from both ends
+  // costs one pointer per edge
+  void indexInEdges(bool Enabled = true);
+
+  // @return true if edges coming into vertices are indexed
+  bool hasInEdgeIndex() const;
+
+  // @return number of edges into given vertex, -1 if vertex not found
+  int inNeighborsSize(const string &Label) const;
+
+  // @return string representing edges into the vertex and their weights,
+  // "" if vertex not found
+  // A-3->C, B-5->C for C should return A(3),B(5)
+  string getInEdgesAsString(const string &Label) const;
+
+  // remove every edge into the vertex, for undirected graphs every edge
+  // @return number of edges removed
+  int disconnectIncoming(const string &Label);
+
   // @return string representing edges and weights, "" if vertex not found
   // A-3->B, A-5->C should return B(3),C(5)
   string getEdgesAsString(const string &Label) const;
@@ -63,14 +185,71 @@ public:
   // @return true if file successfully read
   bool readFile(const string &Filename);
 
+  // read the same format as readFile, faster for large files
+  // the file is mapped and scanned by several threads, 0 or less for one
+  // per core, and the graph built is the same as the one readFile builds
+  // unlike readFile, blank lines are skipped but every counted line must be
+  // "from to weight", and nothing is added if any line is malformed
+  // @return true if file successfully read, otherwise Error, when given,
+  // says why and on which line
+  bool readFileParallel(const string &Filename, int Threads = 0,
+                        string *Error = nullptr);
+
+  // read-only snapshot of the graph packed into contiguous arrays
+  // later changes to the graph are not reflected in the snapshot
+  CsrGraph freeze() const;
+
+  // same as above with weights of type W, such as int64_t, float or
+  // Unweighted, see weightedcsr.h, weights are converted from int
+  // throws out_of_range if a weight does not fit in W
+  template <typename W> WeightedCsr<W> freezeAs() const;
+
+  // traversals, dijkstra and mst do not change the graph, so any number
+  // of them can run at the same time from different threads, as long as
+  // no thread is changing the graph
+
   // depth-first traversal starting from given startLabel
-  // second dfs helper is to be called recursively to go through all vertices
-  void dfs(const string &StartLabel, void Visit(const string &Label));
-  void dfs(Vertex *VertexLocation, void Visit(const string &Label));
+  void dfs(const string &StartLabel, void Visit(const string &Label)) const;
+  // same as above, calling visit with vertex ids
+  void dfs(VertexId Start, void Visit(VertexId Id)) const;
+  // same as above with any callable, such as a lambda that keeps state
+  // Visit may return a VisitResult, Prune does not go deeper from the
+  // vertex and Stop ends the traversal
+  template <typename Visitor>
+  void dfs(const string &StartLabel, Visitor &&Visit) const;
+  template <typename Visitor> void dfs(VertexId Start, Visitor &&Visit) const;
+
+  // vertices reachable from Start in dfs order, found one at a time as the
+  // range is iterated, empty if Start is not found
+  DfsRange dfsRange(const string &StartLabel) const;
+  DfsRange dfsRange(VertexId Start) const;
+
+  // depth-first numbering of the vertices reachable from Start, in the same
+  // order as dfs
+  DfsOrder dfsOrder(VertexId Start) const;
+  // same as above for the whole graph, each vertex not reached yet starts
+  // a new tree, in order of id
+  DfsOrder dfsOrder() const;
 
   // breadth-first traversal starting from startLabel
   // call the function visit on each vertex label */
-  void bfs(const string &StartLabel, void Visit(const string &Label));
+  void bfs(const string &StartLabel, void Visit(const string &Label)) const;
+  void bfs(VertexId Start, void Visit(VertexId Id)) const;
+  // same as above with any callable, Prune does not follow the edges of
+  // the vertex and Stop ends the traversal
+  template <typename Visitor>
+  void bfs(const string &StartLabel, Visitor &&Visit) const;
+  template <typename Visitor> void bfs(VertexId Start, Visitor &&Visit) const;
+
+  // vertices reachable from Start in bfs order, found one at a time
+  BfsRange bfsRange(const string &StartLabel) const;
+  BfsRange bfsRange(VertexId Start) const;
+
+  // breadth-first traversal following edges backwards, visiting the vertices
+  // that can reach StartLabel, nearest first
+  void bfsReverse(const string &StartLabel,
+                  void Visit(const string &Label)) const;
+  void bfsReverse(VertexId Start, void Visit(VertexId Id)) const;
 
   // dijkstra's algorithm to find shortest distance to all other vertices
   // and the path to all other vertices
@@ -79,13 +258,78 @@ public:
   // @return a pair made up of two map objects, Weights and Previous
   pair<map<string, int>, map<string, string>>
   dijkstra(const string &StartLabel) const;
+  // same as above using dense arrays indexed by vertex id
+  // distance is UNREACHABLE and previous is NO_VERTEX for unreachable
+  // vertices, the start vertex has distance 0 and previous NO_VERTEX
+  // both throw overflow_error for a path too long for an int, use
+  // freezeAs<int64_t>() for such graphs
+  pair<vector<int>, vector<VertexId>> dijkstra(VertexId Start) const;
+
+  // shortest path from one vertex to another, settling only the vertices
+  // needed instead of the whole graph
+  // Path is set to the vertices of the path, From first and To last, or
+  // cleared if there is no path
+  // without Estimate, undirected graphs, and directed graphs with the
+  // in-edge index, are searched from both ends at once, other directed
+  // graphs from From only, stopping once To is reached
+  // Estimate, when given, turns the search into A*, it must never be more
+  // than the length of the shortest path from a vertex to To
+  // @return length of the path, -1 if there is none or a vertex is not found
+  // throws overflow_error as dijkstra does
+  int shortestPath(const string &From, const string &To,
+                   vector<string> &Path) const;
+  int shortestPath(VertexId From, VertexId To, vector<VertexId> &Path,
+                   const function<int(VertexId)> &Estimate = nullptr) const;
 
-  // minimum spanning tree
+  // minimum spanning tree of the component containing StartLabel
   // ONLY works for NONDIRECTED graphs
   // ASSUMES the edge [P->Q] has the same weight as [Q->P]
+  // Visit is called once for each edge of the tree, for Prim in the order
+  // the edges join the tree and going away from StartLabel, for Kruskal and
+  // Boruvka lightest first and going from the smaller id to the larger
+  // edges of equal weight are ordered by the ids of their ends, so all
+  // algorithms pick the same edges
+  // Threads is only used by Boruvka, 0 or less for one per core
   // @return length of the minimum spanning tree or -1 if start vertex not
-  int mst(const string &StartLabel,
-          void Visit(const string &From, const string &To, int Weight)) const;
+  // found, summed in 64 bits so heavy trees do not overflow
+  int64_t mst(const string &StartLabel,
+              void Visit(const string &From, const string &To, int Weight),
+              MstAlgorithm Algorithm = MstAlgorithm::Prim,
+              int Threads = 0) const;
+  // same as above with any callable, returning Stop ends the visits but
+  // not the length of the whole tree
+  template <typename Visitor>
+  int64_t mst(const string &StartLabel, Visitor &&Visit,
+              MstAlgorithm Algorithm = MstAlgorithm::Prim,
+              int Threads = 0) const;
+
+  // shortest distances between all pairs of vertices, see DistanceMatrix
+  // FloydWarshall suits dense graphs, Johnson sparse ones, Auto picks by
+  // the number of edges per pair, and Johnson runs whenever the heaviest
+  // weight times verticesSize() - 1 is 2^29 or more
+  // negative weights are allowed, previous vertices are only kept when
+  // KeepPrevious is true
+  // Threads is the number of threads to use, 0 or less for one per core
+  // throws overflow_error if a distance does not fit in an int
+  // @return false if there is a negative cycle, Paths is then empty
+  bool allPairs(DistanceMatrix &Paths,
+                ApspAlgorithm Algorithm = ApspAlgorithm::Auto,
+                bool KeepPrevious = false, int Threads = 0) const;
+
+  // strongly connected components, connected components for undirected
+  // graphs, without the limits of running dfs from every vertex
+  // Tarjan and Kosaraju number the components so that every edge between
+  // two components goes from the smaller number to the larger one
+  // ForwardBackward runs CsrGraph::stronglyConnected on a snapshot with
+  // Threads threads, 0 or less for one per core, for large graphs
+  Components stronglyConnected(SccAlgorithm Algorithm = SccAlgorithm::Tarjan,
+                               int Threads = 0) const;
+
+  // the condensation, a graph with one vertex per component and an edge
+  // between two components when an edge of the graph joins them
+  // it has no cycles, since a cycle would be one component
+  // @return components each component has an edge to, sorted
+  vector<vector<int>> condensation(const Components &Found) const;
 
 private:
   // default is directional edges is true,
@@ -94,24 +338,241 @@ private:
   // create 2 edges, one from P->Q and another from Q->P with same weight
   // Directional edge related values
   bool DirectionalEdges = true;
-  bool NonDirectionalAdded = false;
-  bool NonDirectionalDeleted = false;
   // Stored graph related values
   int Edges = 0;
   int Vertices = 0;
+  // number of changes, see version()
+  uint64_t Version = 0;
+  // memory for all vertices and edges, given back when the graph is destroyed
+  SlabPool<Vertex> VertexPool;
+  SlabPool<Edge> EdgePool;
   // vector to contain all vertices
   vector<Vertex *> AllVertices;
+  // index from vertex label to vertex, kept in sync with AllVertices
+  unordered_map<string, Vertex *> VertexIndex;
   // function to get the location of a given vertex label
   // return true if found, false otherwise
   // NOLINTNEXTLINE
   bool inGraph(const string &Label, Vertex *&VertexLocation) const;
-  // define the order of the priority queue
-  struct PQRule {
-    bool operator()(pair<string, int> const &Lhs,
-                    pair<string, int> const &Rhs) {
-      return Lhs.second > Rhs.second;
-    }
+  // get the vertex with the given label, adding it if it is not in the graph
+  Vertex *findOrAdd(const string &Label);
+  // return true if the id belongs to a vertex in the graph
+  bool validId(VertexId Id) const;
+  // connect/disconnect including the mirror edge for undirected graphs
+  bool connectVertices(Vertex *FromVertex, Vertex *ToVertex, int Weight);
+  bool disconnectVertices(Vertex *FromVertex, Vertex *ToVertex);
+  // add/remove a single directed edge
+  bool addEdge(Vertex *FromVertex, Vertex *ToVertex, int Weight);
+  // an edge waiting to be added by addEdges, Mirror is true for the
+  // reverse edge of an undirected edge
+  struct PendingEdge {
+    VertexId From;
+    VertexId To;
+    int Weight;
+    bool Mirror;
   };
+  // add the pending edges, keeping the first edge from each vertex to each
+  // other vertex, using the pool's threads when one is given
+  // @return number of edges added that are not mirrors
+  int addPendingEdges(const vector<PendingEdge> &Pending,
+                      ThreadPool *Pool = nullptr);
+  // addEdges without the Connect timer, for readFile which is timed as a
+  // whole
+  int addEdgesUntimed(const vector<tuple<string, string, int>> &NewEdges);
+  // addEdges for readFileParallel, with the work split between the threads
+  void addFileEdges(const vector<tuple<string, string, int>> &FileEdges,
+                    ThreadPool &Pool);
+  bool removeEdge(Vertex *FromVertex, Vertex *ToVertex);
+  // @return the edge from one vertex to another, nullptr if there is none
+  Edge *edgeBetween(Vertex *FromVertex, Vertex *ToVertex) const;
+  // seen vertices for each running traversal, instead of flags on vertices
+  mutable VisitedPool VisitedSets;
+  // traversals shared by the label and id versions, the visitors may
+  // return a VisitResult
+  template <typename DiscoverVertex, typename FinishVertex>
+  void dfsFrom(Vertex *VertexLocation, VisitedSet &Visited,
+               DiscoverVertex Discover, FinishVertex Finish) const;
+  void dfsNumber(Vertex *Start, VisitedSet &Visited, DfsOrder &Order) const;
+  template <typename VisitVertex>
+  void bfsFrom(Vertex *VertexLocation, VisitVertex Visit) const;
+  template <typename VisitVertex>
+  void bfsReverseFrom(Vertex *VertexLocation, VisitVertex Visit) const;
+  // true when every vertex keeps its in-edges, see indexInEdges
+  bool InEdgeIndex = false;
+  // in-edges of a vertex sorted by the label they come from
+  vector<Edge *> inEdgesOf(Vertex *VertexLocation) const;
+  // in-edges of all vertices by id, found by looking at every edge
+  vector<vector<Edge *>> transposedEdges() const;
+  // searches used by shortestPath
+  int bidirectionalPath(VertexId From, VertexId To,
+                        vector<VertexId> &Path) const;
+  int searchPath(VertexId From, VertexId To,
+                 const function<int(VertexId)> &Estimate,
+                 vector<VertexId> &Path) const;
+  // all pairs engines, and the bellman-ford potentials that remove
+  // negative weights, empty if there are none
+  bool potentials(vector<int64_t> &Potential) const;
+  void floydWarshall(DistanceMatrix &Paths, bool KeepPrevious,
+                     ThreadPool &Pool) const;
+  void johnson(DistanceMatrix &Paths, const vector<int64_t> &Potential,
+               bool KeepPrevious, ThreadPool &Pool) const;
+  // components used by stronglyConnected
+  Components tarjanScc() const;
+  Components kosarajuScc() const;
+  // mst orders edges by weight, then by the smaller and the larger end
+  using EdgeRank = tuple<int, VertexId, VertexId>;
+  static EdgeRank rankOf(const Edge *E);
+  static bool lighter(const Edge *E1, const Edge *E2);
+  // edges of the minimum spanning tree from StartLabel, false if not found
+  bool mstTree(const string &StartLabel, MstAlgorithm Algorithm, int Threads,
+               vector<Edge *> &Tree) const;
+  // each edge of the component of Start once, from its smaller id end
+  vector<Edge *> componentEdges(Vertex *Start) const;
+  // edges of the minimum spanning tree, in the order mst visits them
+  vector<Edge *> primTree(Vertex *Start) const;
+  vector<Edge *> kruskalTree(Vertex *Start) const;
+  vector<Edge *> boruvkaTree(Vertex *Start, int Threads) const;
 };
 
+template <typename Visitor>
+void Graph::dfs(const string &StartLabel, Visitor &&Visit) const {
+  GRAPH_TIMER(Traversal);
+  Vertex *VertexLocation = nullptr;
+  if (inGraph(StartLabel, VertexLocation)) {
+    auto Visited = VisitedSets.acquire(Vertices);
+    dfsFrom(
+        VertexLocation, *Visited,
+        [&Visit](Vertex *Curr, Vertex * /*Parent*/) {
+          return visitResult(Visit, Curr->Label);
+        },
+        [](Vertex * /*Curr*/) {});
+  }
+}
+
+template <typename Visitor>
+void Graph::dfs(VertexId Start, Visitor &&Visit) const {
+  GRAPH_TIMER(Traversal);
+  if (validId(Start)) {
+    auto Visited = VisitedSets.acquire(Vertices);
+    dfsFrom(
+        AllVertices[Start], *Visited,
+        [&Visit](Vertex *Curr, Vertex * /*Parent*/) {
+          return visitResult(Visit, Curr->Id);
+        },
+        [](Vertex * /*Curr*/) {});
+  }
+}
+
+template <typename Visitor>
+void Graph::bfs(const string &StartLabel, Visitor &&Visit) const {
+  GRAPH_TIMER(Traversal);
+  Vertex *VertexLocation = nullptr;
+  if (inGraph(StartLabel, VertexLocation))
+    bfsFrom(VertexLocation, [&Visit](Vertex *Curr) {
+      return visitResult(Visit, Curr->Label);
+    });
+}
+
+template <typename Visitor>
+void Graph::bfs(VertexId Start, Visitor &&Visit) const {
+  GRAPH_TIMER(Traversal);
+  if (validId(Start))
+    bfsFrom(AllVertices[Start], [&Visit](Vertex *Curr) {
+      return visitResult(Visit, Curr->Id);
+    });
+}
+
+// undirected graphs give each edge once, the snapshot adds the other way
+template <typename W> WeightedCsr<W> Graph::freezeAs() const {
+  vector<WeightedEdge<W>> Packed;
+  Packed.reserve(Edges);
+  for (auto V : AllVertices) {
+    for (auto Neighbor : V->Neighbors) {
+      if (DirectionalEdges || V->Id < Neighbor->To->Id)
+        Packed.push_back(
+            {V->Id, Neighbor->To->Id, weightAs<W>(Neighbor->Weight)});
+    }
+  }
+  return WeightedCsr<W>(Vertices, Packed, DirectionalEdges);
+}
+
+// the length is of the whole tree even if the visitor stops early
+template <typename Visitor>
+int64_t Graph::mst(const string &StartLabel, Visitor &&Visit,
+                   MstAlgorithm Algorithm, int Threads) const {
+  vector<Edge *> Tree;
+  if (!mstTree(StartLabel, Algorithm, Threads, Tree))
+    return -1;
+  int64_t Ans = 0;
+  bool Stopped = false;
+  for (auto E : Tree) {
+    if (!Stopped)
+      Stopped = visitResult(Visit, E->From->Label, E->To->Label, E->Weight) ==
+                VisitResult::Stop;
+    Ans += E->Weight;
+  }
+  return Ans;
+}
+
+// dfs with an explicit stack, so deep graphs cannot overflow the call stack
+// Discover(Vertex, Parent) is called when a vertex is first reached and
+// Finish(Vertex) once all of its neighbors have been looked at, a pruned
+// vertex is finished right away
+// vertices are reached in the same order as a recursive dfs
+template <typename DiscoverVertex, typename FinishVertex>
+void Graph::dfsFrom(Vertex *VertexLocation, VisitedSet &Visited,
+                    DiscoverVertex Discover, FinishVertex Finish) const {
+  // each entry is a vertex and the index of its next neighbor to look at
+  vector<pair<Vertex *, int>> Stack;
+  // @return false if the traversal should stop
+  auto Reach = [&](Vertex *Curr, Vertex *Parent) {
+    VisitResult Result = visitResult(Discover, Curr, Parent);
+    Visited.mark(Curr->Id);
+    GRAPH_COUNT(VerticesVisited, 1);
+    if (Result == VisitResult::Stop)
+      return false;
+    Stack.emplace_back(Curr, Result == VisitResult::Prune
+                                 ? static_cast<int>(Curr->Neighbors.size())
+                                 : 0);
+    return true;
+  };
+  if (!Reach(VertexLocation, nullptr))
+    return;
+  while (!Stack.empty()) {
+    Vertex *Curr = Stack.back().first;
+    int Next = Stack.back().second++;
+    if (Next == Curr->Neighbors.size()) {
+      Finish(Curr);
+      Stack.pop_back();
+      continue;
+    }
+    Vertex *Neighbor = Curr->Neighbors[Next]->To;
+    GRAPH_COUNT(EdgesScanned, 1);
+    if (!Visited.seen(Neighbor->Id) && !Reach(Neighbor, Curr))
+      return;
+  }
+}
+
+// bfs using a queue, VisitVertex is called with each vertex reached
+template <typename VisitVertex>
+void Graph::bfsFrom(Vertex *VertexLocation, VisitVertex Visit) const {
+  auto Visited = VisitedSets.acquire(Vertices);
+  Visited->mark(VertexLocation->Id);
+  vector<Vertex *> Queue(1, VertexLocation);
+  for (int I = 0; I < Queue.size(); ++I) {
+    Vertex *Curr = Queue[I];
+    VisitResult Result = visitResult(Visit, Curr);
+    GRAPH_COUNT(VerticesVisited, 1);
+    if (Result == VisitResult::Stop)
+      return;
+    if (Result == VisitResult::Prune)
+      continue;
+    GRAPH_COUNT(EdgesScanned, Curr->Neighbors.size());
+    for (auto &Neighbor : Curr->Neighbors) {
+      if (Visited->visit(Neighbor->To->Id))
+        Queue.push_back(Neighbor->To);
+    }
+  }
+}
+
 #endif // GRAPH_H
\ No newline at end of file
@@ -0,0 +1,276 @@
+/**
+ * Shortest paths between all pairs of vertices
+ * Floyd-Warshall works on blocks of the distance matrix small enough to
+ * stay in cache, and relaxes a row of a block at a time with AVX2 when the
+ * file is built with it, see GRAPH_AVX2 in CMakeLists.txt
+ * Johnson reweights the edges so none is negative, then runs dijkstra from
+ * every source on a thread pool
+ *
+ * @author Bill Zhao
+ * @date updated on 10/17/2026
+ */
+
+#include "graph.h"
+#include "graphstats.h"
+#include "indexedheap.h"
+#include "threadpool.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+// floyd-warshall relaxes blocks of BLOCK x BLOCK distances
+const int BLOCK = 64;
+// no path inside floyd-warshall, two of them can be added without
+// overflowing, and any distance at least HALF_INFINITE is no path
+const int INFINITE = 1 << 30;
+const int HALF_INFINITE = INFINITE / 2;
+// graphs with at least one edge for every DENSE_RATIO pairs of vertices
+// use floyd-warshall when the algorithm is Auto
+const int64_t DENSE_RATIO = 16;
+
+// RowC[J] = min(RowC[J], Through + RowB[J]) for a row of a block, the
+// previous vertex comes from the pivot row when the distance drops
+// RowC and RowB may be the same row
+template <bool KeepPrevious>
+void relaxRow(int *RowC, const int *RowB, int Through, VertexId *PrevC,
+              const VertexId *PrevB) {
+  int J = 0;
+#ifdef __AVX2__
+  const __m256i Add = _mm256_set1_epi32(Through);
+  for (; J + 8 <= BLOCK; J += 8) {
+    __m256i Old = _mm256_loadu_si256(reinterpret_cast<__m256i *>(RowC + J));
+    __m256i New = _mm256_add_epi32(
+        Add, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(RowB + J)));
+    if (KeepPrevious) {
+      __m256i Shorter = _mm256_cmpgt_epi32(Old, New);
+      auto *Prev = reinterpret_cast<__m256i *>(PrevC + J);
+      __m256i Pivot =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(PrevB + J));
+      _mm256_storeu_si256(
+          Prev, _mm256_blendv_epi8(_mm256_loadu_si256(Prev), Pivot, Shorter));
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(RowC + J),
+                        _mm256_min_epi32(Old, New));
+  }
+#endif
+  // without previous vertices this loop has no branch, so the compiler
+  // can vectorize it for whatever the target has
+  for (; J < BLOCK; ++J) {
+    int New = Through + RowB[J];
+    if (!KeepPrevious) {
+      RowC[J] = min(RowC[J], New);
+    } else if (New < RowC[J]) {
+      RowC[J] = New;
+      PrevC[J] = PrevB[J];
+    }
+  }
+}
+
+// relax the distances of block (IB, JB) through the vertices of block KB,
+// using block (IB, KB) for the way to the pivot and (KB, JB) for the way
+// from it, which are block (IB, JB) itself or the pivot block in the first
+// two phases, so the pivot loop is outermost
+template <bool KeepPrevious>
+void relaxBlock(DistanceMatrix &Paths, int IB, int JB, int KB) {
+  const int Stride = Paths.Stride;
+  auto Corner = [Stride](int Row, int Col) {
+    return static_cast<size_t>(Row) * BLOCK * Stride + Col * BLOCK;
+  };
+  int *C = Paths.Dist.data() + Corner(IB, JB);
+  const int *A = Paths.Dist.data() + Corner(IB, KB);
+  const int *B = Paths.Dist.data() + Corner(KB, JB);
+  VertexId *PrevC = KeepPrevious ? Paths.Prev.data() + Corner(IB, JB) : nullptr;
+  const VertexId *PrevB =
+      KeepPrevious ? Paths.Prev.data() + Corner(KB, JB) : nullptr;
+  for (int K = 0; K < BLOCK; ++K) {
+    for (int I = 0; I < BLOCK; ++I) {
+      const int Through = A[I * Stride + K];
+      if (Through >= HALF_INFINITE)
+        continue;
+      relaxRow<KeepPrevious>(C + I * Stride, B + K * Stride, Through,
+                             KeepPrevious ? PrevC + I * Stride : nullptr,
+                             KeepPrevious ? PrevB + K * Stride : nullptr);
+    }
+  }
+}
+
+// for each pivot block, first the pivot block, then the blocks in its row
+// and column, then all others, each phase split between the threads
+template <bool KeepPrevious>
+void blockedFloydWarshall(DistanceMatrix &Paths, ThreadPool &Pool) {
+  const int Blocks = Paths.Stride / BLOCK;
+  for (int KB = 0; KB < Blocks; ++KB) {
+    relaxBlock<KeepPrevious>(Paths, KB, KB, KB);
+    Pool.parallelFor(Blocks, [&](int Begin, int End, int /*Worker*/) {
+      for (int B = Begin; B < End; ++B) {
+        if (B == KB)
+          continue;
+        relaxBlock<KeepPrevious>(Paths, KB, B, KB);
+        relaxBlock<KeepPrevious>(Paths, B, KB, KB);
+      }
+    });
+    Pool.parallelFor(Blocks, [&](int Begin, int End, int /*Worker*/) {
+      for (int IB = Begin; IB < End; ++IB) {
+        for (int JB = 0; JB < Blocks && IB != KB; ++JB) {
+          if (JB != KB)
+            relaxBlock<KeepPrevious>(Paths, IB, JB, KB);
+        }
+      }
+    });
+  }
+}
+
+} // namespace
+
+// pick the algorithm, negative cycles are found before either runs
+// a shortest path has at most Vertices - 1 edges, so when that many of the
+// heaviest edge could reach HALF_INFINITE floyd-warshall could mistake a
+// path for no path, or overflow, and johnson runs instead
+bool Graph::allPairs(DistanceMatrix &Paths, ApspAlgorithm Algorithm,
+                     bool KeepPrevious, int Threads) const {
+  GRAPH_TIMER(ShortestPath);
+  Paths = DistanceMatrix();
+  vector<int64_t> Potential;
+  if (!potentials(Potential))
+    return false;
+  if (Algorithm == ApspAlgorithm::Auto) {
+    const int64_t Pairs = static_cast<int64_t>(Vertices) * Vertices;
+    Algorithm = Edges * DENSE_RATIO >= Pairs ? ApspAlgorithm::FloydWarshall
+                                             : ApspAlgorithm::Johnson;
+  }
+  int64_t Heaviest = 0;
+  for (auto V : AllVertices) {
+    for (auto Neighbor : V->Neighbors)
+      Heaviest = max(Heaviest, abs(static_cast<int64_t>(Neighbor->Weight)));
+  }
+  if (Heaviest * max(Vertices - 1, 0) >= HALF_INFINITE)
+    Algorithm = ApspAlgorithm::Johnson;
+  ThreadPool Pool(Threads);
+  if (Algorithm == ApspAlgorithm::FloydWarshall)
+    floydWarshall(Paths, KeepPrevious, Pool);
+  else
+    johnson(Paths, Potential, KeepPrevious, Pool);
+  return true;
+}
+
+// bellman-ford from a vertex with an edge of length 0 to every vertex,
+// left empty when no edge is negative
+bool Graph::potentials(vector<int64_t> &Potential) const {
+  Potential.clear();
+  bool Negative = false;
+  for (auto V : AllVertices) {
+    for (auto Neighbor : V->Neighbors)
+      Negative = Negative || Neighbor->Weight < 0;
+  }
+  if (!Negative)
+    return true;
+  Potential.assign(Vertices, 0);
+  for (int Round = 0; Round <= Vertices; ++Round) {
+    bool Changed = false;
+    for (auto V : AllVertices) {
+      for (auto Neighbor : V->Neighbors) {
+        int64_t NewPotential = Potential[V->Id] + Neighbor->Weight;
+        if (NewPotential < Potential[Neighbor->To->Id]) {
+          Potential[Neighbor->To->Id] = NewPotential;
+          Changed = true;
+        }
+      }
+    }
+    if (!Changed)
+      return true;
+  }
+  // still changing after every path could have been found
+  return false;
+}
+
+// distances start as the edges, padded to whole blocks with no path
+void Graph::floydWarshall(DistanceMatrix &Paths, bool KeepPrevious,
+                          ThreadPool &Pool) const {
+  Paths.Size = Vertices;
+  Paths.Stride = (Vertices + BLOCK - 1) / BLOCK * BLOCK;
+  const size_t Cells = static_cast<size_t>(Paths.Stride) * Paths.Stride;
+  Paths.Dist.assign(Cells, INFINITE);
+  if (KeepPrevious)
+    Paths.Prev.assign(Cells, NO_VERTEX);
+  for (auto V : AllVertices) {
+    Paths.Dist[Paths.at(V->Id, V->Id)] = 0;
+    for (auto Neighbor : V->Neighbors) {
+      Paths.Dist[Paths.at(V->Id, Neighbor->To->Id)] = Neighbor->Weight;
+      if (KeepPrevious)
+        Paths.Prev[Paths.at(V->Id, Neighbor->To->Id)] = V->Id;
+    }
+  }
+  if (KeepPrevious)
+    blockedFloydWarshall<true>(Paths, Pool);
+  else
+    blockedFloydWarshall<false>(Paths, Pool);
+  for (size_t Cell = 0; Cell < Cells; ++Cell) {
+    if (Paths.Dist[Cell] >= HALF_INFINITE) {
+      Paths.Dist[Cell] = UNREACHABLE;
+      if (KeepPrevious)
+        Paths.Prev[Cell] = NO_VERTEX;
+    }
+  }
+}
+
+// with Potential, the edge U->V has length Weight + P[U] - P[V], which is
+// not negative, and each path from S to T is longer by P[S] - P[T]
+// each thread keeps its own heap and distances for its sources
+// a distance that does not fit in an int below UNREACHABLE throws
+// overflow_error once every thread is done, leaving Paths empty
+void Graph::johnson(DistanceMatrix &Paths, const vector<int64_t> &Potential,
+                    bool KeepPrevious, ThreadPool &Pool) const {
+  Paths.Size = Vertices;
+  Paths.Stride = Vertices;
+  const size_t Cells = static_cast<size_t>(Vertices) * Vertices;
+  Paths.Dist.assign(Cells, UNREACHABLE);
+  if (KeepPrevious)
+    Paths.Prev.assign(Cells, NO_VERTEX);
+  auto P = [&Potential](VertexId V) {
+    return Potential.empty() ? 0 : Potential[V];
+  };
+  atomic<bool> Overflow(false);
+  Pool.parallelFor(Vertices, [&](int Begin, int End, int /*Worker*/) {
+    IndexedHeap<int64_t> Queue(Vertices);
+    vector<int64_t> Dist(Vertices);
+    // source that settled each vertex last, so nothing needs clearing
+    vector<VertexId> SettledBy(Vertices, NO_VERTEX);
+    for (VertexId Source = Begin; Source < End; ++Source) {
+      Dist[Source] = 0;
+      Queue.push(Source, 0);
+      while (!Queue.empty()) {
+        VertexId Curr = Queue.pop();
+        SettledBy[Curr] = Source;
+        const int64_t Length = Dist[Curr] - P(Source) + P(Curr);
+        if (Length >= UNREACHABLE || Length < numeric_limits<int>::min())
+          Overflow = true;
+        Paths.Dist[Paths.at(Source, Curr)] = static_cast<int>(Length);
+        for (auto Neighbor : AllVertices[Curr]->Neighbors) {
+          VertexId Next = Neighbor->To->Id;
+          int64_t NewDist = Dist[Curr] + Neighbor->Weight + P(Curr) - P(Next);
+          if (SettledBy[Next] == Source ||
+              (Queue.contains(Next) && Queue.key(Next) <= NewDist))
+            continue;
+          Dist[Next] = NewDist;
+          Queue.pushOrDecrease(Next, NewDist);
+          if (KeepPrevious)
+            Paths.Prev[Paths.at(Source, Next)] = Curr;
+        }
+      }
+    }
+  });
+  if (Overflow) {
+    Paths = DistanceMatrix();
+    throw overflow_error("path length does not fit in an int");
+  }
+}
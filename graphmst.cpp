@@ -0,0 +1,199 @@
+/**
+ * Minimum spanning trees of undirected graphs
+ * Prim grows the tree from the start vertex with an indexed heap,
+ * Kruskal adds edges lightest first using a union-find, and
+ * Boruvka joins every component to its lightest neighbor at once,
+ * with the edges split between threads
+ * Edges of equal weight are ordered by the ids of their ends, so all three
+ * find the same tree
+ *
+ * @author Bill Zhao
+ * @date updated on 10/17/2026
+ */
+
+#include "graph.h"
+#include "graphstats.h"
+#include "indexedheap.h"
+#include "threadpool.h"
+#include "unionfind.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <tuple>
+
+using namespace std;
+
+// edges are ordered by weight, then by the smaller and the larger end
+Graph::EdgeRank Graph::rankOf(const Edge *E) {
+  VertexId A = E->From->Id;
+  VertexId B = E->To->Id;
+  return EdgeRank(E->Weight, min(A, B), max(A, B));
+}
+
+// true if E1 comes before E2 in the order above
+bool Graph::lighter(const Edge *E1, const Edge *E2) {
+  return rankOf(E1) < rankOf(E2);
+}
+
+// minimum spanning tree of the component containing the start vertex
+int64_t Graph::mst(const string &StartLabel,
+                   void Visit(const string &From, const string &To,
+                              int Weight),
+                   MstAlgorithm Algorithm, int Threads) const {
+  return mst(
+      StartLabel,
+      [Visit](const string &From, const string &To, int Weight) {
+        Visit(From, To, Weight);
+      },
+      Algorithm, Threads);
+}
+
+// tree edges from the chosen algorithm
+bool Graph::mstTree(const string &StartLabel, MstAlgorithm Algorithm,
+                    int Threads, vector<Edge *> &Tree) const {
+  GRAPH_TIMER(Mst);
+  assert(!DirectionalEdges);
+  Vertex *Start = nullptr;
+  if (!inGraph(StartLabel, Start))
+    return false;
+  switch (Algorithm) {
+  case MstAlgorithm::Prim:
+    Tree = primTree(Start);
+    break;
+  case MstAlgorithm::Kruskal:
+    Tree = kruskalTree(Start);
+    break;
+  case MstAlgorithm::Boruvka:
+    Tree = boruvkaTree(Start, Threads);
+    break;
+  }
+  return true;
+}
+
+// each edge of the component once, from its end with the smaller id
+vector<Edge *> Graph::componentEdges(Vertex *Start) const {
+  auto Visited = VisitedSets.acquire(Vertices);
+  Visited->mark(Start->Id);
+  vector<Vertex *> Component(1, Start);
+  vector<Edge *> ComponentEdges;
+  for (int I = 0; I < Component.size(); ++I) {
+    for (auto Neighbor : Component[I]->Neighbors) {
+      if (Visited->visit(Neighbor->To->Id))
+        Component.push_back(Neighbor->To);
+      if (Component[I]->Id < Neighbor->To->Id)
+        ComponentEdges.push_back(Neighbor);
+    }
+  }
+  return ComponentEdges;
+}
+
+// prim, the heap holds for each vertex next to the tree its lightest edge
+// to the tree, edges go from the tree to the vertex they add
+vector<Edge *> Graph::primTree(Vertex *Start) const {
+  vector<Edge *> Tree;
+  vector<Edge *> Via(Vertices, nullptr);
+  IndexedHeap<EdgeRank> Heap(Vertices);
+  auto InTree = VisitedSets.acquire(Vertices);
+  Vertex *Added = Start;
+  while (true) {
+    InTree->mark(Added->Id);
+    for (auto Neighbor : Added->Neighbors) {
+      VertexId To = Neighbor->To->Id;
+      if (!InTree->seen(To) && Heap.pushOrDecrease(To, rankOf(Neighbor)))
+        Via[To] = Neighbor;
+    }
+    if (Heap.empty())
+      break;
+    VertexId Next = Heap.pop();
+    Tree.push_back(Via[Next]);
+    Added = AllVertices[Next];
+  }
+  return Tree;
+}
+
+// kruskal, lightest edges first, skipping edges inside a tree
+vector<Edge *> Graph::kruskalTree(Vertex *Start) const {
+  // sort the ranks next to the edges, not through the edge pointers
+  vector<pair<EdgeRank, Edge *>> Ranked;
+  for (auto E : componentEdges(Start))
+    Ranked.emplace_back(rankOf(E), E);
+  sort(Ranked.begin(), Ranked.end());
+  UnionFind Trees(Vertices);
+  vector<Edge *> Tree;
+  for (auto &R : Ranked) {
+    if (Trees.unite(get<1>(R.first), get<2>(R.first)))
+      Tree.push_back(R.second);
+  }
+  return Tree;
+}
+
+// boruvka, in each round every tree picks its lightest edge to another tree
+// and all picked edges are added, so the number of trees at least halves
+// picking is done by the threads, each edge offers itself to both trees
+vector<Edge *> Graph::boruvkaTree(Vertex *Start, int Threads) const {
+  const vector<Edge *> ComponentEdges = componentEdges(Start);
+  const int EdgeCount = static_cast<int>(ComponentEdges.size());
+  const int NO_EDGE = EdgeCount;
+  // ranks hold the ends of the edges, so the rounds do not follow pointers
+  vector<EdgeRank> Ranks(EdgeCount);
+  vector<VertexId> Roots(1, Start->Id);
+  for (int I = 0; I < EdgeCount; ++I) {
+    Ranks[I] = rankOf(ComponentEdges[I]);
+    Roots.push_back(get<1>(Ranks[I]));
+    Roots.push_back(get<2>(Ranks[I]));
+  }
+  sort(Roots.begin(), Roots.end());
+  Roots.erase(unique(Roots.begin(), Roots.end()), Roots.end());
+  const vector<VertexId> Component = Roots;
+
+  ThreadPool Pool(Threads);
+  UnionFind Trees(Vertices);
+  // tree of each vertex as of the start of the round
+  vector<VertexId> TreeOf(Vertices);
+  for (VertexId V : Component)
+    TreeOf[V] = V;
+  vector<atomic<int>> Lightest(Vertices);
+  vector<char> Picked(EdgeCount, 0);
+  while (Roots.size() > 1) {
+    for (VertexId Root : Roots)
+      Lightest[Root].store(NO_EDGE, memory_order_relaxed);
+    auto Offer = [&](VertexId Root, int I) {
+      int Current = Lightest[Root].load(memory_order_relaxed);
+      while ((Current == NO_EDGE || Ranks[I] < Ranks[Current]) &&
+             !Lightest[Root].compare_exchange_weak(Current, I,
+                                                   memory_order_relaxed)) {
+      }
+    };
+    Pool.parallelFor(EdgeCount, [&](int Begin, int End, int /*Worker*/) {
+      for (int I = Begin; I < End; ++I) {
+        VertexId A = TreeOf[get<1>(Ranks[I])];
+        VertexId B = TreeOf[get<2>(Ranks[I])];
+        if (A != B) {
+          Offer(A, I);
+          Offer(B, I);
+        }
+      }
+    });
+    // two trees may pick the same edge, unite adds it once
+    for (VertexId Root : Roots) {
+      int I = Lightest[Root].load(memory_order_relaxed);
+      if (I != NO_EDGE && Trees.unite(get<1>(Ranks[I]), get<2>(Ranks[I])))
+        Picked[I] = 1;
+    }
+    Pool.parallelFor(static_cast<int>(Component.size()),
+                     [&](int Begin, int End, int /*Worker*/) {
+                       for (int I = Begin; I < End; ++I)
+                         TreeOf[Component[I]] = Trees.root(Component[I]);
+                     });
+    Roots.erase(remove_if(Roots.begin(), Roots.end(),
+                          [&TreeOf](VertexId V) { return TreeOf[V] != V; }),
+                Roots.end());
+  }
+  vector<Edge *> Tree;
+  for (int I = 0; I < EdgeCount; ++I) {
+    if (Picked[I])
+      Tree.push_back(ComponentEdges[I]);
+  }
+  sort(Tree.begin(), Tree.end(), lighter);
+  return Tree;
+}
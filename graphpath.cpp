@@ -0,0 +1,152 @@
+/**
+ * Shortest path between two vertices
+ * Without a heuristic, on an undirected graph or a directed graph with an
+ * in-edge index, dijkstra runs from both ends at once and stops when the
+ * two searches cannot find anything shorter than the best path through a
+ * vertex both have reached
+ * Otherwise one search runs from the start, ordered by distance plus the
+ * estimate of the rest, and stops when the target leaves the heap
+ *
+ * @author Bill Zhao
+ * @date updated on 10/17/2026
+ */
+
+#include "graph.h"
+#include "graphstats.h"
+#include "indexedheap.h"
+#include <algorithm>
+#include <cstdint>
+
+using namespace std;
+
+namespace {
+
+// one direction of a bidirectional search
+struct SearchSide {
+  vector<int> Dist;
+  vector<VertexId> Prev;
+  IndexedHeap<int> Queue;
+  explicit SearchSide(int Size)
+      : Dist(Size, UNREACHABLE), Prev(Size, NO_VERTEX), Queue(Size) {}
+};
+
+} // namespace
+
+// shortest path between two labels
+int Graph::shortestPath(const string &From, const string &To,
+                        vector<string> &Path) const {
+  Path.clear();
+  vector<VertexId> Ids;
+  int Length = shortestPath(idOf(From), idOf(To), Ids);
+  for (VertexId Id : Ids)
+    Path.push_back(AllVertices[Id]->Label);
+  return Length;
+}
+
+// pick the search, see the header
+int Graph::shortestPath(VertexId From, VertexId To, vector<VertexId> &Path,
+                        const function<int(VertexId)> &Estimate) const {
+  GRAPH_TIMER(ShortestPath);
+  Path.clear();
+  if (!validId(From) || !validId(To))
+    return -1;
+  if (Estimate || (DirectionalEdges && !InEdgeIndex))
+    return searchPath(From, To, Estimate, Path);
+  return bidirectionalPath(From, To, Path);
+}
+
+// dijkstra from both ends, always growing the side whose next vertex is
+// closer, a path is found whenever a vertex is reached by both sides
+// once the two closest unsettled vertices add up to at least the best
+// path, no path through them can be shorter
+int Graph::bidirectionalPath(VertexId From, VertexId To,
+                             vector<VertexId> &Path) const {
+  SearchSide Forward(Vertices);
+  SearchSide Backward(Vertices);
+  Forward.Dist[From] = 0;
+  Forward.Queue.push(From, 0);
+  Backward.Dist[To] = 0;
+  Backward.Queue.push(To, 0);
+  GRAPH_COUNT(HeapPushes, 2);
+  int64_t Best = From == To ? 0 : UNREACHABLE;
+  VertexId Meet = From == To ? From : NO_VERTEX;
+  while (!Forward.Queue.empty() && !Backward.Queue.empty()) {
+    int ForwardTop = Forward.Queue.key(Forward.Queue.top());
+    int BackwardTop = Backward.Queue.key(Backward.Queue.top());
+    if (static_cast<int64_t>(ForwardTop) + BackwardTop >= Best)
+      break;
+    bool GrowForward = ForwardTop <= BackwardTop;
+    SearchSide &Side = GrowForward ? Forward : Backward;
+    SearchSide &Other = GrowForward ? Backward : Forward;
+    VertexId Curr = Side.Queue.pop();
+    GRAPH_COUNT(VerticesSettled, 1);
+    auto Relax = [&](VertexId Next, int Weight) {
+      int NewDist = pathLength(Side.Dist[Curr], Weight);
+      if (NewDist < Side.Dist[Next]) {
+        Side.Dist[Next] = NewDist;
+        Side.Prev[Next] = Curr;
+        Side.Queue.pushOrDecrease(Next, NewDist);
+        GRAPH_COUNT(EdgesRelaxed, 1);
+        GRAPH_COUNT(HeapPushes, 1);
+      }
+      if (Other.Dist[Next] != UNREACHABLE &&
+          static_cast<int64_t>(Side.Dist[Next]) + Other.Dist[Next] < Best) {
+        Best = static_cast<int64_t>(Side.Dist[Next]) + Other.Dist[Next];
+        Meet = Next;
+      }
+    };
+    // going backwards follows the in-edges, in undirected graphs the edges
+    // out of a vertex also lead into it
+    if (GrowForward || !DirectionalEdges) {
+      for (auto Neighbor : AllVertices[Curr]->Neighbors)
+        Relax(Neighbor->To->Id, Neighbor->Weight);
+    } else {
+      for (auto InEdge : AllVertices[Curr]->InEdges)
+        Relax(InEdge->From->Id, InEdge->Weight);
+    }
+  }
+  if (Meet == NO_VERTEX)
+    return -1;
+  for (VertexId V = Meet; V != NO_VERTEX; V = Forward.Prev[V])
+    Path.push_back(V);
+  reverse(Path.begin(), Path.end());
+  for (VertexId V = Backward.Prev[Meet]; V != NO_VERTEX; V = Backward.Prev[V])
+    Path.push_back(V);
+  return static_cast<int>(Best);
+}
+
+// dijkstra, or A* with an estimate, stopping when the target is settled
+// a vertex whose distance drops after it left the heap is put back, so an
+// estimate that never overestimates is enough even if it is not consistent
+int Graph::searchPath(VertexId From, VertexId To,
+                      const function<int(VertexId)> &Estimate,
+                      vector<VertexId> &Path) const {
+  SearchSide Side(Vertices);
+  auto Rest = [&Estimate](VertexId V) { return Estimate ? Estimate(V) : 0; };
+  Side.Dist[From] = 0;
+  Side.Queue.push(From, Rest(From));
+  GRAPH_COUNT(HeapPushes, 1);
+  while (!Side.Queue.empty()) {
+    VertexId Curr = Side.Queue.pop();
+    GRAPH_COUNT(VerticesSettled, 1);
+    if (Curr == To)
+      break;
+    for (auto Neighbor : AllVertices[Curr]->Neighbors) {
+      VertexId Next = Neighbor->To->Id;
+      int NewDist = pathLength(Side.Dist[Curr], Neighbor->Weight);
+      if (NewDist < Side.Dist[Next]) {
+        Side.Dist[Next] = NewDist;
+        Side.Prev[Next] = Curr;
+        Side.Queue.pushOrDecrease(Next, pathLength(NewDist, Rest(Next)));
+        GRAPH_COUNT(EdgesRelaxed, 1);
+        GRAPH_COUNT(HeapPushes, 1);
+      }
+    }
+  }
+  if (Side.Dist[To] == UNREACHABLE)
+    return -1;
+  for (VertexId V = To; V != NO_VERTEX; V = Side.Prev[V])
+    Path.push_back(V);
+  reverse(Path.begin(), Path.end());
+  return Side.Dist[To];
+}
@@ -0,0 +1,157 @@
+/**
+ * Counters and timers for graph operations
+ * Slots of running threads are added up when asked for, slots of threads
+ * that have ended are folded into one set of retired totals
+ *
+ * @author Bill Zhao
+ * @date updated on 10/17/2026
+ */
+
+#include "graphstats.h"
+#include <mutex>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+const int COUNTERS = static_cast<int>(GraphCounter::Count);
+const int PHASES = static_cast<int>(GraphPhase::Count);
+
+// fields of GraphStats in the order of the slots
+uint64_t GraphStats::*const CounterFields[COUNTERS] = {
+    &GraphStats::LabelLookups,    &GraphStats::VerticesAdded,
+    &GraphStats::EdgesAdded,      &GraphStats::VerticesVisited,
+    &GraphStats::EdgesScanned,    &GraphStats::VerticesSettled,
+    &GraphStats::EdgesRelaxed,    &GraphStats::HeapPushes};
+const char *const CounterNames[COUNTERS] = {
+    "LabelLookups",    "VerticesAdded", "EdgesAdded",   "VerticesVisited",
+    "EdgesScanned",    "VerticesSettled", "EdgesRelaxed", "HeapPushes"};
+
+GraphPhaseStats GraphStats::*const PhaseFields[PHASES] = {
+    &GraphStats::ReadFile, &GraphStats::Connect, &GraphStats::Traversal,
+    &GraphStats::ShortestPath, &GraphStats::Mst};
+const char *const PhaseNames[PHASES] = {"ReadFile", "Connect", "Traversal",
+                                        "ShortestPath", "Mst"};
+
+} // namespace
+
+// json object with one number per counter and one object per phase
+string GraphStats::toJson() const {
+  string Json = "{";
+  for (int I = 0; I < COUNTERS; ++I) {
+    Json += string(I == 0 ? "" : ", ") + "\"" + CounterNames[I] +
+            "\": " + to_string(this->*CounterFields[I]);
+  }
+  for (int I = 0; I < PHASES; ++I) {
+    const GraphPhaseStats &Phase = this->*PhaseFields[I];
+    Json += string(", \"") + PhaseNames[I] + "\": {\"Calls\": " +
+            to_string(Phase.Calls) +
+            ", \"Nanoseconds\": " + to_string(Phase.Nanoseconds) + "}";
+  }
+  return Json + "}";
+}
+
+#ifdef GRAPH_INSTRUMENTATION
+
+namespace {
+
+using Totals = vector<uint64_t>;
+
+// slots of all threads that have counted
+class StatsRegistry {
+public:
+  StatsRegistry() : Retired(ThreadStats::SLOTS), Baseline(ThreadStats::SLOTS) {}
+
+  void enter(ThreadStats *Stats) {
+    lock_guard<mutex> Guard(Lock);
+    Live.push_back(Stats);
+  }
+
+  // keep the counts of a thread that is ending
+  void leave(ThreadStats *Stats) {
+    lock_guard<mutex> Guard(Lock);
+    for (int I = 0; I < ThreadStats::SLOTS; ++I)
+      Retired[I] += Stats->Slots[I].load(memory_order_relaxed);
+    for (auto &L : Live) {
+      if (L == Stats) {
+        L = Live.back();
+        Live.pop_back();
+        break;
+      }
+    }
+  }
+
+  // @return counts since the last reset
+  Totals current() {
+    lock_guard<mutex> Guard(Lock);
+    Totals Sum = sum();
+    for (int I = 0; I < ThreadStats::SLOTS; ++I)
+      Sum[I] -= Baseline[I];
+    return Sum;
+  }
+
+  // threads keep counting up, later counts are taken relative to now
+  void reset() {
+    lock_guard<mutex> Guard(Lock);
+    Baseline = sum();
+  }
+
+private:
+  mutex Lock;
+  vector<ThreadStats *> Live;
+  Totals Retired;
+  Totals Baseline;
+
+  Totals sum() const {
+    Totals Sum = Retired;
+    for (auto Stats : Live) {
+      for (int I = 0; I < ThreadStats::SLOTS; ++I)
+        Sum[I] += Stats->Slots[I].load(memory_order_relaxed);
+    }
+    return Sum;
+  }
+};
+
+// never destroyed, threads may end after static objects are gone
+StatsRegistry &registry() {
+  static auto *Registry = new StatsRegistry();
+  return *Registry;
+}
+
+// slots of one thread, registered while the thread runs
+struct ThreadStatsOwner {
+  ThreadStats Stats;
+  ThreadStatsOwner() { registry().enter(&Stats); }
+  ~ThreadStatsOwner() { registry().leave(&Stats); }
+};
+
+} // namespace
+
+ThreadStats &ThreadStats::registerThread() {
+  static thread_local ThreadStatsOwner Owner;
+  localPointer() = &Owner.Stats;
+  return Owner.Stats;
+}
+
+GraphStats graphStats() {
+  Totals Sum = registry().current();
+  GraphStats Stats;
+  for (int I = 0; I < COUNTERS; ++I)
+    Stats.*CounterFields[I] = Sum[I];
+  for (int I = 0; I < PHASES; ++I) {
+    (Stats.*PhaseFields[I]).Calls = Sum[COUNTERS + 2 * I];
+    (Stats.*PhaseFields[I]).Nanoseconds = Sum[COUNTERS + 2 * I + 1];
+  }
+  return Stats;
+}
+
+void resetGraphStats() { registry().reset(); }
+
+#else
+
+GraphStats graphStats() { return GraphStats(); }
+
+void resetGraphStats() {}
+
+#endif // GRAPH_INSTRUMENTATION
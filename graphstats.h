@@ -0,0 +1,149 @@
+/**
+ * Counters and timers for graph operations, to find out why a call was slow
+ * Built only when GRAPH_INSTRUMENTATION is defined, cmake option of the
+ * same name, otherwise GRAPH_COUNT and GRAPH_TIMER expand to nothing and
+ * their arguments are not evaluated
+ * Each thread counts into its own slots, so counting takes no lock and
+ * threads do not share cache lines, graphStats adds up all threads
+ *
+ * @author Bill Zhao
+ * @date updated on 10/17/2026
+ */
+
+#ifndef GRAPHSTATS_H
+#define GRAPHSTATS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+using namespace std;
+
+// what is counted, one slot each
+enum class GraphCounter {
+  LabelLookups,
+  VerticesAdded,
+  EdgesAdded,
+  VerticesVisited,
+  EdgesScanned,
+  VerticesSettled,
+  EdgesRelaxed,
+  HeapPushes,
+  Count
+};
+
+// what is timed, each has a number of calls and a total time
+enum class GraphPhase { ReadFile, Connect, Traversal, ShortestPath, Mst, Count };
+
+struct GraphPhaseStats {
+  uint64_t Calls = 0;
+  uint64_t Nanoseconds = 0;
+};
+
+// counts of all threads since the last resetGraphStats
+struct GraphStats {
+  // labels looked up in the index, including lookups that add a vertex
+  uint64_t LabelLookups = 0;
+  uint64_t VerticesAdded = 0;
+  uint64_t EdgesAdded = 0;
+  // vertices reached and edges looked at by bfs and dfs
+  uint64_t VerticesVisited = 0;
+  uint64_t EdgesScanned = 0;
+  // vertices taken off the heap and edges that shortened a distance
+  // by dijkstra and shortestPath
+  uint64_t VerticesSettled = 0;
+  uint64_t EdgesRelaxed = 0;
+  // heap pushes, including decreases of a key already in the heap
+  uint64_t HeapPushes = 0;
+  // readFile and readFileParallel
+  // phases do not nest, the edges added while reading a file are timed
+  // as ReadFile only
+  GraphPhaseStats ReadFile;
+  // connect and addEdges, called from outside the graph
+  GraphPhaseStats Connect;
+  // bfs, bfsReverse, dfs and dfsOrder
+  GraphPhaseStats Traversal;
+  // dijkstra and shortestPath
+  GraphPhaseStats ShortestPath;
+  GraphPhaseStats Mst;
+
+  // @return all counts as one json object
+  string toJson() const;
+};
+
+// @return counts of all threads, all zero without GRAPH_INSTRUMENTATION
+GraphStats graphStats();
+
+// start counting again from zero
+void resetGraphStats();
+
+#ifdef GRAPH_INSTRUMENTATION
+
+// slots of one thread, only that thread writes them
+struct alignas(64) ThreadStats {
+  // counters, then calls and nanoseconds of each phase
+  enum : int {
+    COUNTERS = static_cast<int>(GraphCounter::Count),
+    PHASES = static_cast<int>(GraphPhase::Count),
+    SLOTS = COUNTERS + 2 * PHASES
+  };
+  atomic<uint64_t> Slots[SLOTS] = {};
+
+  // @return slots of the calling thread
+  static ThreadStats &local() {
+    ThreadStats *Local = localPointer();
+    return Local != nullptr ? *Local : registerThread();
+  }
+
+  // add to a slot, the load and store are not a locked add since no
+  // other thread writes the slot
+  void add(int Slot, uint64_t N) {
+    Slots[Slot].store(Slots[Slot].load(memory_order_relaxed) + N,
+                      memory_order_relaxed);
+  }
+
+private:
+  // plain pointer, so reading it needs no thread_local initialization
+  static ThreadStats *&localPointer() {
+    static thread_local ThreadStats *Local = nullptr;
+    return Local;
+  }
+  // slots for a thread that has not counted before
+  static ThreadStats &registerThread();
+};
+
+// adds the time between its construction and destruction to a phase
+class ScopedGraphTimer {
+public:
+  explicit ScopedGraphTimer(GraphPhase Phase)
+      : Phase(Phase), Start(chrono::steady_clock::now()) {}
+  ~ScopedGraphTimer() {
+    auto Elapsed = chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now() - Start);
+    ThreadStats &Local = ThreadStats::local();
+    int Slot = ThreadStats::COUNTERS + 2 * static_cast<int>(Phase);
+    Local.add(Slot, 1);
+    Local.add(Slot + 1, static_cast<uint64_t>(Elapsed.count()));
+  }
+  ScopedGraphTimer(const ScopedGraphTimer &) = delete;
+  ScopedGraphTimer &operator=(const ScopedGraphTimer &) = delete;
+
+private:
+  GraphPhase Phase;
+  chrono::steady_clock::time_point Start;
+};
+
+#define GRAPH_COUNT(Counter, N)                                                \
+  ThreadStats::local().add(static_cast<int>(GraphCounter::Counter),            \
+                           static_cast<uint64_t>(N))
+#define GRAPH_TIMER(Phase) ScopedGraphTimer GraphTimer(GraphPhase::Phase)
+
+#else
+
+#define GRAPH_COUNT(Counter, N) static_cast<void>(0)
+#define GRAPH_TIMER(Phase) static_cast<void>(0)
+
+#endif // GRAPH_INSTRUMENTATION
+
+#endif // GRAPHSTATS_H
@@ -5,11 +5,25 @@
  * @date 19 Oct 2019, updated on 2/5/2020
  */
 
+#include "concurrentbuilder.h"
+#include "dynamicpaths.h"
 #include "graph.h"
+#include "graphstats.h"
+#include "pathqueries.h"
+#include "versionedgraph.h"
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <tuple>
 
 using namespace std;
 
@@ -27,15 +41,55 @@ public:
   static void resetSs() { SS.str(string()); }
   // visitor function used for dfs and BFS
   static void labelVisitor(const string &Label) { SS << Label; }
+  // visitor function used for id based dfs and bfs
+  static void idVisitor(VertexId Id) { SS << Id << " "; }
+  // visitor function used for each level of the parallel bfs
+  static void levelVisitor(int Depth, const vector<VertexId> &Level) {
+    SS << Depth << ":";
+    for (VertexId Id : Level)
+      SS << Id;
+    SS << " ";
+  }
+  // visitor function that can be used by several threads at once,
+  // each thread has its own Trace
+  static thread_local string Trace;
+  static void traceVisitor(const string &Label) { Trace += Label; }
+  static void traceEdgeVisitor(const string &From, const string &To,
+                               int Weight) {
+    Trace += "[" + From + To + " " + to_string(Weight) + "]";
+  }
   // visitor function used for edges for minimum spanning tree
   static void edgeVisitor(const string &From, const string &To, int Weight) {
     SS << "[" << From << To << " " << Weight << "]";
   }
 };
 
-// initialize the static variable
+// initialize the static variables
 // NOLINTNEXTLINE
 stringstream Tester::SS;
+// NOLINTNEXTLINE
+thread_local string Tester::Trace;
+
+// next number below Range from a linear congruential generator, the same
+// Seed always gives the same numbers
+static int nextRandom(unsigned &Seed, int Range) {
+  Seed = Seed * 1103515245 + 12345;
+  return static_cast<int>((Seed >> 8) % Range);
+}
+
+// Count random edges between vertices V0 to V<Vertices - 1>, with weights
+// from 0 to MaxWeight, repeats and loops included
+static vector<tuple<string, string, int>>
+randomEdges(int Count, int Vertices, int MaxWeight, unsigned Seed) {
+  vector<tuple<string, string, int>> Edges;
+  for (int I = 0; I < Count; ++I) {
+    int From = nextRandom(Seed, Vertices);
+    int To = nextRandom(Seed, Vertices);
+    Edges.emplace_back("V" + to_string(From), "V" + to_string(To),
+                       nextRandom(Seed, MaxWeight + 1));
+  }
+  return Edges;
+}
 
 // convert a map to a string so we can compare it
 template <typename K, typename L>
@@ -186,12 +240,12 @@ void testGraph0NotDirected() {
   map<string, int> Weights;
   map<string, string> Previous;
   tie(Weights, Previous) = G.dijkstra("A");
-  assert(map2string(Weights) == "[B:1]" && "Dijkstra(A) weights");
-  assert(map2string(Previous) == "[B:A]" && "Dijkstra(A) previous");
+  assert(map2string(Weights) == "[B:1][C:4]" && "Dijkstra(A) weights");
+  assert(map2string(Previous) == "[B:A][C:B]" && "Dijkstra(A) previous");
 
   tie(Weights, Previous) = G.dijkstra("B");
-  assert(map2string(Weights) == "[A:1]" && "Dijkstra(B) weights");
-  assert(map2string(Previous) == "[A:B]" && "Dijkstra(B) previous");
+  assert(map2string(Weights) == "[A:1][C:3]" && "Dijkstra(B) weights");
+  assert(map2string(Previous) == "[A:B][C:B]" && "Dijkstra(B) previous");
 
   tie(Weights, Previous) = G.dijkstra("X");
   assert(map2string(Weights).empty() && "Dijkstra(C) weights");
@@ -246,13 +300,1514 @@ void testGraph1() {
   auto P = G.dijkstra("A");
   Weights = P.first;
   Previous = P.second;
-  assert(map2string(Weights) == "[B:1][C:2][D:3][E:4][F:5][G:6]" &&
-         "Dijkstra(B) weights");
-  assert(map2string(Previous) == "[B:A][C:B][D:C][E:D][F:E][G:F]" &&
-         "Dijkstra(B) previous");
+  assert(map2string(Weights) == "[B:1][C:2][D:3][E:4][F:5][G:4][H:3]" &&
+         "Dijkstra(A) weights");
+  assert(map2string(Previous) == "[B:A][C:B][D:C][E:D][F:E][G:H][H:A]" &&
+         "Dijkstra(A) previous");
   cout << "testGraph1 (PASSED)" << endl;
 }
 
+// test dijkstra on the larger input files
+void testGraph2And4Dijkstra() {
+  cout << "testGraph2And4Dijkstra" << endl;
+  Graph G2;
+  if (!G2.readFile("graph2.txt"))
+    return;
+  map<string, int> Weights;
+  map<string, string> Previous;
+  tie(Weights, Previous) = G2.dijkstra("O");
+  assert(map2string(Weights) == "[P:5][Q:2][R:3][S:6][T:8][U:9]" &&
+         "Dijkstra(O) weights");
+  assert(map2string(Previous) == "[P:O][Q:O][R:Q][S:R][T:S][U:S]" &&
+         "Dijkstra(O) previous");
+  tie(Weights, Previous) = G2.dijkstra("D");
+  assert(map2string(Weights) == "[H:0][I:0][M:0][N:0]" && "Dijkstra(D)");
+  assert(map2string(Previous) == "[H:D][I:D][M:H][N:I]" && "Dijkstra(D)");
+
+  Graph G4;
+  if (!G4.readFile("graph4.txt"))
+    return;
+  tie(Weights, Previous) = G4.dijkstra("A");
+  assert(map2string(Weights) ==
+             "[B:6][D:15][E:2][F:2][G:3][H:8][I:3][J:5][K:4][L:11]" &&
+         "Dijkstra(A) weights");
+  assert(map2string(Previous) ==
+             "[B:A][D:B][E:A][F:A][G:E][H:A][I:E][J:E][K:I][L:H]" &&
+         "Dijkstra(A) previous");
+  // the snapshot gives the same answer from every vertex
+  CsrGraph Csr = G4.freeze();
+  for (VertexId V = 0; V < G4.verticesSize(); ++V)
+    assert(G4.dijkstra(G4.labelOf(V)) == Csr.dijkstra(G4.labelOf(V)));
+  cout << "testGraph2And4Dijkstra (PASSED)" << endl;
+}
+
+// test the vertex id based functions
+void testGraphIds() {
+  cout << "testGraphIds" << endl;
+  Graph G;
+  if (!G.readFile("graph1.txt"))
+    return;
+  assert(G.idOf("A") == 0 && G.idOf("H") == 7 && G.idOf("Y") == 9);
+  assert(G.idOf("xxx") == NO_VERTEX && "no id for xxx");
+  assert(G.labelOf(G.idOf("G")) == "G" && "label of id");
+  VertexId Id = NO_VERTEX;
+  assert(!G.add("B", Id) && Id == 1 && "existing vertex keeps its id");
+  assert(G.add("Z", Id) && Id == 10 && "new vertex gets next id");
+
+  assert(G.connect(G.idOf("Y"), Id, 2) && "connect by id");
+  assert(!G.connect(Id, Id, 2) && "connect id to itself");
+  assert(!G.connect(Id, 99, 2) && "connect to invalid id");
+  assert(G.getEdgesAsString("Y") == "Z(2)" && "edge added by id");
+
+  Tester::resetSs();
+  G.bfs(0, Tester::idVisitor);
+  assert(Tester::getSs() == "0 1 7 2 6 3 4 5 " && "bfs by id from A");
+  Tester::resetSs();
+  G.dfs(8, Tester::idVisitor);
+  assert(Tester::getSs() == "8 9 10 " && "dfs by id from X");
+  Tester::resetSs();
+  G.dfs(99, Tester::idVisitor);
+  assert(Tester::getSs().empty() && "dfs from invalid id");
+
+  vector<int> Dist;
+  vector<VertexId> Prev;
+  tie(Dist, Prev) = G.dijkstra(G.idOf("A"));
+  assert(Dist.size() == G.verticesSize() && "one distance per vertex");
+  assert(Dist[0] == 0 && Prev[0] == NO_VERTEX && "start vertex");
+  assert(Dist[G.idOf("G")] == 4 && Prev[G.idOf("G")] == G.idOf("H"));
+  assert(Dist[G.idOf("F")] == 5 && Prev[G.idOf("F")] == G.idOf("E"));
+  assert(Dist[G.idOf("X")] == UNREACHABLE && Prev[G.idOf("X")] == NO_VERTEX);
+
+  assert(G.disconnect(G.idOf("A"), G.idOf("H")) && "disconnect by id");
+  assert(!G.disconnect(G.idOf("A"), G.idOf("H")) && "already disconnected");
+  tie(Dist, Prev) = G.dijkstra(G.idOf("A"));
+  assert(Dist[G.idOf("H")] == UNREACHABLE && Dist[G.idOf("G")] == 6);
+  cout << "testGraphIds (PASSED)" << endl;
+}
+
+// test the read-only compressed snapshot gives the same results as the graph
+void testCsrGraph() {
+  cout << "testCsrGraph" << endl;
+  Graph G;
+  if (!G.readFile("graph1.txt"))
+    return;
+  CsrGraph Csr = G.freeze();
+  assert(Csr.verticesSize() == G.verticesSize() && "same vertices");
+  assert(Csr.edgesSize() == G.edgesSize() && "same edges");
+  assert(Csr.contains("H") && !Csr.contains("xxx") && "contains");
+  assert(Csr.neighborsSize("A") == 2 && Csr.neighborsSize("xxx") == -1);
+  assert(Csr.getEdgesAsString("A") == G.getEdgesAsString("A"));
+
+  Tester::resetSs();
+  Csr.dfs("A", Tester::labelVisitor);
+  assert(Tester::getSs() == "ABCDEFGH" && "csr dfs starting from A");
+
+  Tester::resetSs();
+  Csr.bfs("A", Tester::labelVisitor);
+  assert(Tester::getSs() == "ABHCGDEF" && "csr bfs starting from A");
+
+  Tester::resetSs();
+  Csr.bfs("X", Tester::labelVisitor);
+  assert(Tester::getSs() == "XY" && "csr bfs starting from X");
+
+  map<string, int> Weights;
+  map<string, string> Previous;
+  tie(Weights, Previous) = Csr.dijkstra("A");
+  assert(map2string(Weights) == "[B:1][C:2][D:3][E:4][F:5][G:4][H:3]" &&
+         "csr Dijkstra(A) weights");
+  assert(map2string(Previous) == "[B:A][C:B][D:C][E:D][F:E][G:H][H:A]" &&
+         "csr Dijkstra(A) previous");
+  tie(Weights, Previous) = Csr.dijkstra("xxx");
+  assert(Weights.empty() && Previous.empty() && "csr Dijkstra(xxx)");
+
+  assert(Csr.idOf("H") == G.idOf("H") && Csr.labelOf(7) == "H" && "same ids");
+  vector<int> Dist;
+  vector<VertexId> Prev;
+  tie(Dist, Prev) = Csr.dijkstra(Csr.idOf("A"));
+  assert(Dist == G.dijkstra(G.idOf("A")).first && "same dense distances");
+
+  // changes after freezing are not part of the snapshot
+  G.connect("Y", "Z", 1);
+  assert(!Csr.contains("Z") && "snapshot is not updated");
+
+  Graph U(false);
+  if (!U.readFile("graph0.txt"))
+    return;
+  CsrGraph UCsr = U.freeze();
+  Tester::resetSs();
+  assert(UCsr.mst("A", Tester::edgeVisitor) == 4 && "csr mst A is 4");
+  assert(Tester::getSs() == "[AB 1][BC 3]" && "csr mst edges from A");
+  Tester::resetSs();
+  assert(UCsr.mst("C", Tester::edgeVisitor) == 4 && "csr mst C is 4");
+  assert(Tester::getSs() == "[CB 3][BA 1]" && "csr mst edges from C");
+  Tester::resetSs();
+  assert(UCsr.mst("X", Tester::edgeVisitor) == -1 && "csr mst X is -1");
+  assert(Tester::getSs().empty() && "csr mst for vertex not found");
+  cout << "testCsrGraph (PASSED)" << endl;
+}
+
+// true if Run throws overflow_error
+template <typename Function> static bool overflows(Function Run) {
+  try {
+    Run();
+  } catch (const overflow_error &) {
+    return true;
+  }
+  return false;
+}
+
+// test parallel delta-stepping against dijkstra
+void testDeltaStepping() {
+  cout << "testDeltaStepping" << endl;
+  for (const string Filename : {"graph2.txt", "graph4.txt"}) {
+    Graph G;
+    if (!G.readFile(Filename))
+      return;
+    CsrGraph Csr = G.freeze();
+    for (VertexId V = 0; V < G.verticesSize(); ++V) {
+      const string &Label = G.labelOf(V);
+      for (int Threads : {1, 4}) {
+        for (int Delta : {0, 1, 3, 100}) {
+          assert(Csr.deltaStepping(Label, Delta, Threads) ==
+                     G.dijkstra(Label) &&
+                 "delta-stepping matches dijkstra");
+        }
+      }
+    }
+    assert(Csr.deltaStepping("xxx").first.empty() && "no start vertex");
+  }
+
+  // random graph with many equal length paths, distances must match
+  Graph G;
+  for (const auto &Edge : randomEdges(2000, 300, 9, 12345))
+    G.connect(get<0>(Edge), get<1>(Edge), get<2>(Edge));
+  CsrGraph Csr = G.freeze();
+  vector<int> Dist = G.dijkstra(0).first;
+  for (int Threads : {1, 3, 8}) {
+    auto Paths = Csr.deltaStepping(0, 2, Threads);
+    assert(Paths.first == Dist && "delta-stepping distances");
+    assert(Paths == Csr.deltaStepping(0, 5, 1) && "previous is repeatable");
+  }
+
+  // packed distances cannot hold negative weights or sums past an int
+  Graph Long;
+  Long.connect("A", "B", 2000000000);
+  Long.connect("B", "C", 2000000000);
+  for (int Threads : {1, 3})
+    assert(overflows([&]() { Long.freeze().deltaStepping(0, 0, Threads); }));
+  Long.setWeight("B", "C", -1);
+  bool Refused = false;
+  try {
+    Long.freeze().deltaStepping(0);
+  } catch (const invalid_argument &) {
+    Refused = true;
+  }
+  assert(Refused && "negative weight");
+  cout << "testDeltaStepping (PASSED)" << endl;
+}
+
+// check depth and parent arrays from a parallel bfs against a plain bfs
+static void checkBfsTree(const Graph &G, const CsrGraph &Csr, VertexId Start,
+                         const pair<vector<int>, vector<VertexId>> &Tree) {
+  vector<int> Depth(G.verticesSize(), -1);
+  vector<VertexId> Queue{Start};
+  Depth[Start] = 0;
+  for (int Head = 0; Head < Queue.size(); ++Head) {
+    VertexId Curr = Queue[Head];
+    string Edges = "," + Csr.getEdgesAsString(G.labelOf(Curr));
+    for (VertexId Next = 0; Next < G.verticesSize(); ++Next) {
+      if (Depth[Next] == -1 &&
+          Edges.find("," + G.labelOf(Next) + "(") != string::npos) {
+        Depth[Next] = Depth[Curr] + 1;
+        Queue.push_back(Next);
+      }
+    }
+  }
+  assert(Tree.first == Depth && "parallel bfs depths");
+  for (VertexId V = 0; V < G.verticesSize(); ++V) {
+    VertexId P = Tree.second[V];
+    if (V == Start || Depth[V] == -1) {
+      assert(P == NO_VERTEX && "no parent for start or unreachable");
+      continue;
+    }
+    string Edges = "," + Csr.getEdgesAsString(G.labelOf(P));
+    assert(Depth[P] == Depth[V] - 1 && "parent is one level up");
+    assert(Edges.find("," + G.labelOf(V) + "(") != string::npos &&
+           "parent has an edge to the vertex");
+  }
+}
+
+// test direction-optimizing parallel bfs
+void testParallelBfs() {
+  cout << "testParallelBfs" << endl;
+  Graph G;
+  if (!G.readFile("graph1.txt"))
+    return;
+  CsrGraph Csr = G.freeze();
+  Tester::resetSs();
+  auto Tree = Csr.parallelBfs(G.idOf("A"), 2, Tester::levelVisitor);
+  assert(Tester::getSs() == "0:0 1:17 2:26 3:3 4:4 5:5 " && "levels from A");
+  checkBfsTree(G, Csr, G.idOf("A"), Tree);
+  Tree = Csr.parallelBfs(99);
+  assert(Tree.first == vector<int>(G.verticesSize(), -1) && "invalid start");
+
+  // dense random graphs, so both top-down and bottom-up steps are used
+  for (bool Directed : {true, false}) {
+    Graph R(Directed);
+    for (const auto &Edge : randomEdges(3000, 400, 0, 777))
+      R.connect(get<0>(Edge), get<1>(Edge), 1);
+    CsrGraph RCsr = R.freeze();
+    for (int Threads : {1, 4})
+      checkBfsTree(R, RCsr, 0, RCsr.parallelBfs(0, Threads));
+  }
+  cout << "testParallelBfs (PASSED)" << endl;
+}
+
+// test writing a snapshot to a binary file and mapping it back
+void testCsrGraphFile() {
+  cout << "testCsrGraphFile" << endl;
+  const string Filename = "graphtest-snapshot.bin";
+  for (bool Directed : {true, false}) {
+    Graph G(Directed);
+    if (!G.readFile("graph4.txt"))
+      return;
+    CsrGraph Csr = G.freeze();
+    assert(Csr.writeFile(Filename) && "snapshot written");
+    CsrGraph Mapped;
+    assert(Mapped.mapFile(Filename) && "snapshot mapped");
+    remove(Filename.c_str());
+    assert(Mapped.verticesSize() == G.verticesSize() &&
+           Mapped.edgesSize() == G.edgesSize() && "same size");
+    for (VertexId V = 0; V < G.verticesSize(); ++V) {
+      const string &Label = G.labelOf(V);
+      assert(Mapped.idOf(Label) == V && Mapped.labelOf(V) == Label);
+      assert(Mapped.getEdgesAsString(Label) == G.getEdgesAsString(Label));
+      assert(Mapped.dijkstra(Label) == G.dijkstra(Label));
+      assert(Mapped.parallelBfs(V, 2).first == Csr.parallelBfs(V, 2).first);
+      Tester::Trace.clear();
+      G.dfs(Label, Tester::traceVisitor);
+      string Expected = Tester::Trace;
+      Tester::Trace.clear();
+      Mapped.dfs(Label, Tester::traceVisitor);
+      assert(Tester::Trace == Expected && "same dfs from mapped file");
+    }
+    assert(!Mapped.contains("xxx") && Mapped.idOf("") == NO_VERTEX);
+    // copies share the mapping, which stays valid after the original is gone
+    CsrGraph Copy = Mapped;
+    Mapped = CsrGraph();
+    assert(Copy.getEdgesAsString("A") == G.getEdgesAsString("A"));
+    assert(Mapped.verticesSize() == 0 && !Mapped.contains("A"));
+  }
+  CsrGraph Empty;
+  assert(Empty.writeFile(Filename) && "empty snapshot written");
+  assert(Empty.mapFile(Filename) && Empty.verticesSize() == 0);
+  // not a snapshot file
+  CsrGraph Csr;
+  assert(!Csr.mapFile("graph0.txt") && "text file is rejected");
+  assert(!Csr.mapFile("no-such-file.bin") && "missing file");
+  // a target or an interior offset out of range, or two sorted ids out of
+  // label order, is caught when mapping with Verify
+  // OffsetsAt, TargetsAt and SortedIdsAt are at bytes 40, 48 and 96
+  Graph Small;
+  Small.readFile("graph4.txt");
+  Small.freeze().writeFile(Filename);
+  assert(Csr.mapFile(Filename, true) && "a good file passes");
+  for (int64_t Field : {40, 48, 96}) {
+    ifstream Input(Filename, ios::binary);
+    string Bytes((istreambuf_iterator<char>(Input)),
+                 istreambuf_iterator<char>());
+    Input.close();
+    int64_t At = 0;
+    memcpy(&At, &Bytes[Field], sizeof(At));
+    string Changed = Bytes;
+    if (Field == 96) {
+      swap_ranges(&Changed[At], &Changed[At + sizeof(int)],
+                  &Changed[At + sizeof(int)]);
+    } else {
+      const int Corrupt = 1 << 20;
+      memcpy(&Changed[At + sizeof(int)], &Corrupt, sizeof(Corrupt));
+    }
+    ofstream(Filename + ".bad", ios::binary) << Changed;
+    assert(!Csr.mapFile(Filename + ".bad", true) && "corrupt file is rejected");
+    assert(Csr.mapFile(Filename + ".bad") && "only the header is checked");
+    remove((Filename + ".bad").c_str());
+  }
+  remove(Filename.c_str());
+  cout << "testCsrGraphFile (PASSED)" << endl;
+}
+
+// test dfs numbering and dfs on a graph too deep for recursion
+void testDfsOrder() {
+  cout << "testDfsOrder" << endl;
+  Graph G;
+  if (!G.readFile("graph1.txt"))
+    return;
+  DfsOrder Order = G.dfsOrder(G.idOf("A"));
+  // A B C D E F G H X Y
+  assert(Order.PreOrder == vector<int>({0, 1, 2, 3, 4, 5, 6, 7, -1, -1}));
+  assert(Order.PostOrder == vector<int>({7, 5, 4, 3, 2, 1, 0, 6, -1, -1}));
+  assert(Order.Discovery == vector<int>({0, 1, 2, 3, 4, 5, 6, 13, -1, -1}));
+  assert(Order.Finish == vector<int>({15, 12, 11, 10, 9, 8, 7, 14, -1, -1}));
+  assert(Order.Parent[G.idOf("H")] == G.idOf("A") &&
+         Order.Parent[G.idOf("A")] == NO_VERTEX && "dfs tree parents");
+
+  Order = G.dfsOrder();
+  assert(Order.Visited == 10 && Order.Finished == 10 && Order.Time == 20);
+  assert(Order.Discovery[G.idOf("X")] == 16 && Order.Finish[G.idOf("X")] == 19);
+  assert(Order.Parent[G.idOf("X")] == NO_VERTEX && "X starts a new tree");
+
+  // a back edge makes a cycle: its target is an ancestor of its source
+  G.connect("F", "C", 1);
+  Order = G.dfsOrder();
+  VertexId F = G.idOf("F");
+  VertexId C = G.idOf("C");
+  assert(Order.Discovery[C] < Order.Discovery[F] &&
+         Order.Finish[F] < Order.Finish[C] && "F->C is a back edge");
+
+  // a long chain, the recursive dfs ran out of stack on graphs like this
+  Graph Chain;
+  const int Length = 300000;
+  for (int I = 0; I < Length; ++I)
+    Chain.connect(to_string(I), to_string(I + 1), 1);
+  Tester::Trace.clear();
+  Chain.dfs("0", Tester::traceVisitor);
+  assert(Tester::Trace.size() > Length && "dfs reaches the end of the chain");
+  Order = Chain.dfsOrder(0);
+  assert(Order.PostOrder[0] == Length && Order.PostOrder[Length] == 0);
+  cout << "testDfsOrder (PASSED)" << endl;
+}
+
+// test many threads querying the same graph at once get the same answers
+// as a single thread
+void testConcurrentQueries() {
+  cout << "testConcurrentQueries" << endl;
+  Graph G;
+  if (!G.readFile("graph4.txt"))
+    return;
+  Graph U(false);
+  if (!U.readFile("graph0.txt"))
+    return;
+  vector<string> Dfs;
+  vector<string> Bfs;
+  vector<pair<map<string, int>, map<string, string>>> Paths;
+  for (VertexId V = 0; V < G.verticesSize(); ++V) {
+    Tester::Trace.clear();
+    G.dfs(G.labelOf(V), Tester::traceVisitor);
+    Dfs.push_back(Tester::Trace);
+    Tester::Trace.clear();
+    G.bfs(G.labelOf(V), Tester::traceVisitor);
+    Bfs.push_back(Tester::Trace);
+    Paths.push_back(G.dijkstra(G.labelOf(V)));
+  }
+  Tester::Trace.clear();
+  int MstLength = U.mst("A", Tester::traceEdgeVisitor);
+  string MstEdges = Tester::Trace;
+
+  const int Threads = 8;
+  vector<int> Failures(Threads, 0);
+  vector<thread> Workers;
+  for (int T = 0; T < Threads; ++T) {
+    Workers.emplace_back([&, T]() {
+      for (int Round = 0; Round < 200; ++Round) {
+        VertexId V = (T * 7 + Round) % G.verticesSize();
+        Tester::Trace.clear();
+        G.dfs(G.labelOf(V), Tester::traceVisitor);
+        Failures[T] += Tester::Trace != Dfs[V];
+        Tester::Trace.clear();
+        G.bfs(G.labelOf(V), Tester::traceVisitor);
+        Failures[T] += Tester::Trace != Bfs[V];
+        Failures[T] += G.dijkstra(G.labelOf(V)) != Paths[V];
+        Tester::Trace.clear();
+        Failures[T] += U.mst("A", Tester::traceEdgeVisitor) != MstLength;
+        Failures[T] += Tester::Trace != MstEdges;
+      }
+    });
+  }
+  for (auto &Worker : Workers)
+    Worker.join();
+  for (int Failed : Failures)
+    assert(Failed == 0 && "concurrent queries give the same results");
+  cout << "testConcurrentQueries (PASSED)" << endl;
+}
+
+// bulk edges must give the same graph as connecting the edges one at a time
+void testBulkEdges() {
+  cout << "testBulkEdges" << endl;
+  for (bool Directional : {true, false}) {
+    vector<tuple<string, string, int>> NewEdges =
+        randomEdges(3000, 200, 9, 777);
+    Graph One(Directional);
+    Graph Bulk(Directional);
+    One.connect("V5", "V7", 1);
+    Bulk.connect("V5", "V7", 1);
+    int Connected = 0;
+    for (auto &E : NewEdges)
+      Connected += One.connect(get<0>(E), get<1>(E), get<2>(E));
+    assert(Bulk.addEdges(NewEdges) == Connected && "same edges connected");
+    assert(Bulk.verticesSize() == One.verticesSize() && "same vertices");
+    assert(Bulk.edgesSize() == One.edgesSize() && "same number of edges");
+    for (VertexId V = 0; V < One.verticesSize(); ++V) {
+      assert(Bulk.labelOf(V) == One.labelOf(V) && "same vertex ids");
+      assert(Bulk.getEdgesAsString(Bulk.labelOf(V)) ==
+                 One.getEdgesAsString(One.labelOf(V)) &&
+             "same sorted edges");
+    }
+    assert(Bulk.addEdges(NewEdges) == 0 && "all edges already exist");
+  }
+  cout << "testBulkEdges (PASSED)" << endl;
+}
+
+// the parallel reader must build the same graph as readFile
+void testReadFileParallel() {
+  cout << "testReadFileParallel" << endl;
+  // big enough to be cut into several chunks
+  const string Filename = "test-parallel.txt";
+  {
+    ofstream Output(Filename);
+    Output << "\n 30000\n";
+    auto Edges = randomEdges(30000, 5000, 49, 99);
+    for (int I = 0; I < Edges.size(); ++I) {
+      Output << get<0>(Edges[I]) << "\t " << get<1>(Edges[I]) << "  "
+             << get<2>(Edges[I]) - 10 << "\r\n";
+      if (I % 1000 == 0)
+        Output << "\n";
+    }
+    Output << "comments after the counted lines are not read\n";
+  }
+  for (const string Name :
+       {"graph0.txt", "graph1.txt", "graph2.txt", "graph3.txt", "graph4.txt",
+        Filename.c_str()}) {
+    for (bool Directional : {true, false}) {
+      Graph Expected(Directional);
+      assert(Expected.readFile(Name));
+      for (int Threads : {1, 4}) {
+        Graph G(Directional);
+        string Error;
+        assert(G.readFileParallel(Name, Threads, &Error) && Error.empty());
+        assert(G.verticesSize() == Expected.verticesSize() &&
+               "same vertices");
+        assert(G.edgesSize() == Expected.edgesSize() && "same edges");
+        for (VertexId V = 0; V < G.verticesSize(); ++V) {
+          assert(G.labelOf(V) == Expected.labelOf(V) && "same ids");
+          assert(G.getEdgesAsString(G.labelOf(V)) ==
+                     Expected.getEdgesAsString(G.labelOf(V)) &&
+                 "same edges");
+        }
+      }
+    }
+  }
+
+  // malformed lines are reported with their line number
+  auto errorOf = [&Filename](const string &Contents) {
+    {
+      ofstream Output(Filename);
+      Output << Contents;
+    }
+    Graph G;
+    string Error;
+    bool Read = G.readFileParallel(Filename, 2, &Error);
+    assert(!Read && G.verticesSize() == 0 && "nothing added on error");
+    return Error;
+  };
+  assert(errorOf("") == "line 1: missing number of edges");
+  assert(errorOf("x\n") == "line 1: expected the number of edges");
+  assert(errorOf("2\nA B 1\n\nA C\n") ==
+         "line 4: expected \"from to weight\"");
+  assert(errorOf("1\nA B 99999999999\n") ==
+         "line 2: expected \"from to weight\"");
+  assert(errorOf("3\nA B 1\n") == "file ends after 1 of 3 edges");
+  remove(Filename.c_str());
+  Graph G;
+  string Error;
+  assert(!G.readFileParallel(Filename, 1, &Error) && "no file");
+  assert(Error == "cannot open " + Filename);
+  cout << "testReadFileParallel (PASSED)" << endl;
+}
+
+// edges freed by disconnect are reused, and the report adds up
+void testMemoryUsage() {
+  cout << "testMemoryUsage" << endl;
+  Graph G;
+  if (!G.readFile("graph1.txt"))
+    return;
+  GraphMemory Before = G.memoryUsage();
+  assert(Before.EdgeBytes >= G.edgesSize() * sizeof(Edge) && "edge pool");
+  assert(Before.VertexBytes >= G.verticesSize() * sizeof(Vertex));
+  assert(Before.NeighborBytes >= G.edgesSize() * sizeof(Edge *));
+  assert(Before.LabelBytes == 0 && "short labels are stored in the string");
+  assert(Before.IndexBytes > 0 && Before.total() > Before.EdgeBytes);
+
+  assert(G.disconnect("A", "B") && G.disconnect("A", "H"));
+  assert(G.memoryUsage().FreeEdges == Before.FreeEdges + 2 && "freed slots");
+  assert(G.connect("A", "B", 1) && G.connect("B", "A", 1));
+  GraphMemory After = G.memoryUsage();
+  assert(After.EdgeBytes == Before.EdgeBytes && "slots reused");
+  assert(After.FreeEdges == Before.FreeEdges && "no slots left over");
+
+  const string Long(100, 'L');
+  assert(G.add(Long));
+  GraphMemory WithLong = G.memoryUsage();
+  assert(WithLong.LabelBytes > Long.size() && "long label counted");
+  assert(WithLong.IndexBytes > After.IndexBytes + Long.size() &&
+         "index keeps its own copy of the label");
+  cout << "testMemoryUsage (PASSED)" << endl;
+}
+
+// all mst algorithms find the same tree
+void testMst() {
+  cout << "testMst" << endl;
+  Graph G(false);
+  if (!G.readFile("graph0.txt"))
+    return;
+  Tester::resetSs();
+  assert(G.mst("A", Tester::edgeVisitor) == 4 && "mst A is 4");
+  assert(Tester::getSs() == "[AB 1][BC 3]" && "prim goes away from A");
+  Tester::resetSs();
+  assert(G.mst("C", Tester::edgeVisitor) == 4 && "mst C is 4");
+  assert(Tester::getSs() == "[CB 3][BA 1]" && "prim goes away from C");
+  // ids are A 0, C 1, B 2
+  for (MstAlgorithm Algorithm : {MstAlgorithm::Kruskal, MstAlgorithm::Boruvka}) {
+    for (const string Start : {"A", "C"}) {
+      Tester::resetSs();
+      assert(G.mst(Start, Tester::edgeVisitor, Algorithm) == 4);
+      assert(Tester::getSs() == "[AB 1][CB 3]" &&
+             "lightest first, from the smaller id");
+    }
+  }
+
+  // only the component of the start vertex
+  Graph Parts(false);
+  if (!Parts.readFile("graph1.txt"))
+    return;
+  for (MstAlgorithm Algorithm : {MstAlgorithm::Prim, MstAlgorithm::Kruskal,
+                                 MstAlgorithm::Boruvka}) {
+    Tester::resetSs();
+    assert(Parts.mst("Y", Tester::edgeVisitor, Algorithm) == 10);
+    assert((Tester::getSs() == "[YX 10]" || Tester::getSs() == "[XY 10]") &&
+           "mst of the component of Y");
+  }
+
+  // random graph with many equal weights, one tree whatever the algorithm
+  Graph R(false);
+  for (const auto &Edge : randomEdges(3000, 500, 4, 4242))
+    R.connect(get<0>(Edge), get<1>(Edge), get<2>(Edge));
+  const string Start = R.labelOf(0);
+  Tester::resetSs();
+  int Length = R.mst(Start, Tester::edgeVisitor, MstAlgorithm::Kruskal);
+  const string Edges = Tester::getSs();
+  assert(Length == R.freeze().mst(Start, Tester::edgeVisitor) &&
+         "same length as the snapshot");
+  for (int Threads : {1, 4}) {
+    Tester::resetSs();
+    assert(R.mst(Start, Tester::edgeVisitor, MstAlgorithm::Boruvka,
+                 Threads) == Length);
+    assert(Tester::getSs() == Edges && "boruvka picks the same edges");
+  }
+  Tester::Trace.clear();
+  assert(R.mst(Start, Tester::traceEdgeVisitor) == Length && "prim length");
+  assert(count(Tester::Trace.begin(), Tester::Trace.end(), '[') ==
+             count(Edges.begin(), Edges.end(), '[') &&
+         "prim has as many edges");
+  cout << "testMst (PASSED)" << endl;
+}
+
+// cached shortest paths match dijkstra and are dropped when the graph changes
+void testPathQueries() {
+  cout << "testPathQueries" << endl;
+  Graph G;
+  if (!G.readFile("graph4.txt"))
+    return;
+  vector<string> Sources;
+  for (VertexId V = 0; V < G.verticesSize(); ++V)
+    Sources.push_back(G.labelOf(V));
+  Sources.push_back("xxx");
+  Sources.push_back(G.labelOf(0));
+  PathQueries Queries(G, 100, 4);
+  auto Results = Queries.dijkstra(Sources);
+  assert(Results.size() == Sources.size() && "one result per source");
+  for (VertexId V = 0; V < G.verticesSize(); ++V)
+    assert(*Results[V] == G.dijkstra(V) && "same as dijkstra");
+  assert(Results[G.verticesSize()] == nullptr && "no result for xxx");
+  assert(Results.back() == Results.front() && "asked twice, computed once");
+  assert(Queries.misses() == G.verticesSize() && Queries.hits() == 0);
+
+  auto Again = Queries.dijkstra(Sources);
+  assert(Again.front() == Results.front() && "answered from the cache");
+  assert(Queries.hits() == Sources.size() - 1 && "all cached");
+
+  // any change to the graph drops the cache
+  VertexId A = 0;
+  VertexId B = G.verticesSize() - 1;
+  G.connect(G.labelOf(A), G.labelOf(B), 0);
+  auto Changed = Queries.dijkstra(G.labelOf(A));
+  assert(Changed != Results.front() && *Changed == G.dijkstra(A));
+  assert(Queries.size() == 1 && "cache was dropped");
+
+  // least recently used source goes first
+  PathQueries Small(G, 2, 1);
+  Small.dijkstra(G.labelOf(0));
+  Small.dijkstra(G.labelOf(1));
+  Small.dijkstra(G.labelOf(0));
+  Small.dijkstra(G.labelOf(2));
+  assert(Small.size() == 2 && Small.misses() == 3 && Small.hits() == 1);
+  Small.dijkstra(G.labelOf(0));
+  assert(Small.hits() == 2 && "0 was used more recently than 1");
+  Small.dijkstra(G.labelOf(1));
+  assert(Small.misses() == 4 && "1 was dropped");
+  cout << "testPathQueries (PASSED)" << endl;
+}
+
+// weight of the edge From->To read from getEdgesAsString, -1 if none
+static int edgeWeightOf(const Graph &G, const string &From, const string &To) {
+  const string Edges = "," + G.getEdgesAsString(From);
+  size_t At = Edges.find("," + To + "(");
+  if (At == string::npos)
+    return -1;
+  return stoi(Edges.substr(At + To.size() + 2));
+}
+
+// check that the path is made of edges of G and adds up to Length
+static bool isPath(const Graph &G, const vector<VertexId> &Path, int Length) {
+  int Sum = 0;
+  for (int I = 0; I + 1 < Path.size(); ++I) {
+    int Weight = edgeWeightOf(G, G.labelOf(Path[I]), G.labelOf(Path[I + 1]));
+    if (Weight < 0)
+      return false;
+    Sum += Weight;
+  }
+  return Sum == Length;
+}
+
+// point to point shortest paths match dijkstra
+void testShortestPath() {
+  cout << "testShortestPath" << endl;
+  Graph G;
+  if (!G.readFile("graph1.txt"))
+    return;
+  vector<string> Path;
+  assert(G.shortestPath("A", "G", Path) == 4 && "A to G is 4");
+  assert(Path == vector<string>({"A", "H", "G"}) && "A to G goes by H");
+  assert(G.shortestPath("G", "A", Path) == -1 && Path.empty() && "one way");
+  assert(G.shortestPath("A", "xxx", Path) == -1 && "no vertex xxx");
+  assert(G.shortestPath("C", "C", Path) == 0 && Path.size() == 1);
+
+  Graph U(false);
+  if (!U.readFile("graph0.txt"))
+    return;
+  assert(U.shortestPath("C", "A", Path) == 4 && "C to A is 4");
+  assert(Path == vector<string>({"C", "B", "A"}) && "C to A goes by B");
+
+  // random graphs, both kinds, with many equal length paths
+  for (bool Directional : {true, false}) {
+    Graph R(Directional);
+    for (const auto &Edge : randomEdges(1500, 400, 5, 321))
+      R.connect(get<0>(Edge), get<1>(Edge), get<2>(Edge));
+    vector<VertexId> Ids;
+    for (VertexId From = 0; From < R.verticesSize(); From += 37) {
+      vector<int> Dist = R.dijkstra(From).first;
+      for (VertexId To = 0; To < R.verticesSize(); To += 7) {
+        int Length = R.shortestPath(From, To, Ids);
+        if (Dist[To] == UNREACHABLE) {
+          assert(Length == -1 && Ids.empty() && "no path");
+          continue;
+        }
+        assert(Length == Dist[To] && "same length as dijkstra");
+        assert(Ids.front() == From && Ids.back() == To && isPath(R, Ids, Length));
+      }
+    }
+  }
+
+  // A* on a grid, the estimate is the number of steps left
+  const int Side = 30;
+  Graph Grid(false);
+  auto Cell = [](int Row, int Column) {
+    return to_string(Row) + "," + to_string(Column);
+  };
+  unsigned Seed = 55;
+  for (int Row = 0; Row < Side; ++Row) {
+    for (int Column = 0; Column < Side; ++Column) {
+      int Weight = 1 + nextRandom(Seed, 4);
+      if (Column + 1 < Side)
+        Grid.connect(Cell(Row, Column), Cell(Row, Column + 1), Weight);
+      if (Row + 1 < Side)
+        Grid.connect(Cell(Row, Column), Cell(Row + 1, Column), 5 - Weight);
+    }
+  }
+  VertexId Target = Grid.idOf(Cell(Side - 1, Side - 2));
+  auto StepsLeft = [&Grid, Target](VertexId V) {
+    const string &Here = Grid.labelOf(V);
+    const string &There = Grid.labelOf(Target);
+    size_t H = Here.find(',');
+    size_t T = There.find(',');
+    return abs(stoi(Here) - stoi(There)) +
+           abs(stoi(Here.substr(H + 1)) - stoi(There.substr(T + 1)));
+  };
+  vector<VertexId> Ids;
+  for (VertexId From = 0; From < Grid.verticesSize(); From += 53) {
+    int Length = Grid.shortestPath(From, Target, Ids, StepsLeft);
+    assert(Length == Grid.dijkstra(From).first[Target] && "A* length");
+    assert(isPath(Grid, Ids, Length) && "A* path");
+  }
+  cout << "testShortestPath (PASSED)" << endl;
+}
+
+// in-edge queries give the same answers with and without the index
+void testInEdges() {
+  cout << "testInEdges" << endl;
+  for (bool Indexed : {false, true}) {
+    Graph G;
+    if (Indexed)
+      G.indexInEdges();
+    if (!G.readFile("graph1.txt"))
+      return;
+    assert(G.hasInEdgeIndex() == Indexed);
+    assert(G.inNeighborsSize("G") == 2 && G.inNeighborsSize("A") == 0);
+    assert(G.inNeighborsSize("xxx") == -1 && "no vertex xxx");
+    assert(G.getInEdgesAsString("G") == "F(1),H(1)" && "edges into G");
+    Tester::resetSs();
+    G.bfsReverse("G", Tester::labelVisitor);
+    assert(Tester::getSs() == "GFHEADCB" && "vertices that reach G");
+    Tester::resetSs();
+    G.bfsReverse(G.idOf("Y"), Tester::idVisitor);
+    assert(Tester::getSs() == "9 8 " && "ids that reach Y");
+
+    assert(G.connect("X", "G", 2) && G.disconnect("F", "G"));
+    assert(G.getInEdgesAsString("G") == "H(1),X(2)" && "kept up to date");
+    int Edges = G.edgesSize();
+    assert(G.disconnectIncoming("G") == 2 && G.inNeighborsSize("G") == 0);
+    assert(G.edgesSize() == Edges - 2 && G.getEdgesAsString("H").empty());
+  }
+
+  Graph U(false);
+  if (!U.readFile("graph0.txt"))
+    return;
+  U.indexInEdges();
+  assert(U.getInEdgesAsString("A") == "B(1),C(8)" && "mirror edges");
+  assert(U.disconnectIncoming("B") == 2 && U.edgesSize() == 2);
+
+  // bulk edges keep the index sorted, and searching directed graphs from
+  // both ends gives the same lengths as dijkstra
+  vector<tuple<string, string, int>> NewEdges =
+      randomEdges(2000, 300, 5, 2024);
+  Graph Scanned;
+  Graph Indexed;
+  Indexed.indexInEdges();
+  Scanned.addEdges(NewEdges);
+  Indexed.connect("V1", "V2", 3);
+  Indexed.addEdges(NewEdges);
+  Scanned.connect("V1", "V2", 3);
+  vector<VertexId> Path;
+  for (VertexId V = 0; V < Scanned.verticesSize(); ++V) {
+    const string &Label = Scanned.labelOf(V);
+    assert(Indexed.getInEdgesAsString(Label) ==
+               Scanned.getInEdgesAsString(Label) &&
+           "same in-edges");
+    vector<int> Dist = Indexed.dijkstra(Indexed.idOf(Label)).first;
+    for (VertexId To = 0; To < Indexed.verticesSize(); To += 13) {
+      int Length = Indexed.shortestPath(Indexed.idOf(Label), To, Path);
+      assert(Length == (Dist[To] == UNREACHABLE ? -1 : Dist[To]) &&
+             "both ends search");
+    }
+  }
+  cout << "testInEdges (PASSED)" << endl;
+}
+
+// paths kept by DynamicPaths have the distances of dijkstra, and each
+// previous vertex has an edge that ends a shortest path
+static bool sameAsDijkstra(const Graph &G, DynamicPaths &Dynamic,
+                           const string &Source) {
+  const DynamicPaths::Paths *Kept = Dynamic.paths(Source);
+  vector<int> Dist = G.dijkstra(G.idOf(Source)).first;
+  if (Kept == nullptr || Kept->first != Dist)
+    return false;
+  for (VertexId V = 0; V < G.verticesSize(); ++V) {
+    VertexId Prev = Kept->second[V];
+    if (Prev == NO_VERTEX) {
+      if (Dist[V] != UNREACHABLE && G.labelOf(V) != Source)
+        return false;
+      continue;
+    }
+    int Weight = edgeWeightOf(G, G.labelOf(Prev), G.labelOf(V));
+    if (Weight < 0 || Dist[Prev] + Weight != Dist[V])
+      return false;
+  }
+  return true;
+}
+
+void testDynamicPaths() {
+  cout << "testDynamicPaths" << endl;
+  Graph G1;
+  if (!G1.readFile("graph1.txt"))
+    return;
+  DynamicPaths Small(G1);
+  assert(G1.hasInEdgeIndex() && "directed graphs need in-edges");
+  assert(Small.track("A") && !Small.track("xxx") && Small.trackedSize() == 1);
+  assert(!Small.setWeight("A", "G", 1) && !Small.disconnect("A", "xxx"));
+  assert(Small.paths("B") == nullptr && sameAsDijkstra(G1, Small, "A"));
+  assert(Small.setWeight("A", "B", 9) && edgeWeightOf(G1, "A", "B") == 9);
+  assert(sameAsDijkstra(G1, Small, "A") && "heavier tree edge");
+  assert(Small.connect("A", "Z", 1) && Small.paths("A")->first.size() ==
+                                           G1.verticesSize());
+  assert(sameAsDijkstra(G1, Small, "A") && "new vertex");
+  G1.connect("Z", "G", 0);
+  assert(sameAsDijkstra(G1, Small, "A") && "changed without DynamicPaths");
+  // repairs put back an in-edge index that was turned off
+  G1.indexInEdges(false);
+  assert(Small.setWeight("A", "B", 20) && G1.hasInEdgeIndex());
+  assert(sameAsDijkstra(G1, Small, "A") && "index turned off");
+  assert(Small.untrack("A") && !Small.untrack("A"));
+
+  // a stream of random changes, checked after each one
+  for (bool Directed : {true, false}) {
+    Graph G(Directed);
+    unsigned Seed = 77;
+    auto Next = [&Seed](int Range) { return nextRandom(Seed, Range); };
+    vector<pair<string, string>> Pairs;
+    vector<tuple<string, string, int>> NewEdges = randomEdges(300, 60, 9, 78);
+    for (const auto &Edge : NewEdges)
+      Pairs.emplace_back(get<0>(Edge), get<1>(Edge));
+    G.addEdges(NewEdges);
+    DynamicPaths Dynamic(G);
+    const vector<string> Tracked = {"V0", "V1", "V2"};
+    for (auto &Source : Tracked)
+      assert(Dynamic.track(Source));
+    for (int Change = 0; Change < 300; ++Change) {
+      auto &Pair = Pairs[Next(static_cast<int>(Pairs.size()))];
+      switch (Next(3)) {
+      case 0:
+        Pairs.emplace_back("V" + to_string(Next(70)), "V" + to_string(Next(70)));
+        Dynamic.connect(Pairs.back().first, Pairs.back().second, Next(10));
+        break;
+      case 1:
+        Dynamic.disconnect(Pair.first, Pair.second);
+        break;
+      default:
+        Dynamic.setWeight(Pair.first, Pair.second, Next(10));
+      }
+      for (auto &Source : Tracked)
+        assert(sameAsDijkstra(G, Dynamic, Source) && "repaired paths");
+    }
+    assert(Dynamic.repaired() < 300 * Tracked.size() * G.verticesSize() &&
+           "less than running dijkstra after every change");
+  }
+  cout << "testDynamicPaths (PASSED)" << endl;
+}
+
+// true if both numberings put the same vertices together
+static bool samePartition(const Components &C1, const Components &C2) {
+  if (C1.Count != C2.Count || C1.Component.size() != C2.Component.size())
+    return false;
+  vector<int> Match(C1.Count, -1);
+  for (int V = 0; V < C1.Component.size(); ++V) {
+    int &M = Match[C1.Component[V]];
+    if (M == -1)
+      M = C2.Component[V];
+    if (M != C2.Component[V])
+      return false;
+  }
+  return true;
+}
+
+void testStronglyConnected() {
+  cout << "testStronglyConnected" << endl;
+  Graph G;
+  G.connect("A", "B");
+  G.connect("B", "C");
+  G.connect("C", "A");
+  G.connect("C", "D");
+  G.connect("D", "E");
+  G.connect("E", "D");
+  G.add("F");
+  for (auto Algorithm : {SccAlgorithm::Tarjan, SccAlgorithm::Kosaraju,
+                         SccAlgorithm::ForwardBackward}) {
+    Components Found = G.stronglyConnected(Algorithm, 2);
+    const vector<int> &C = Found.Component;
+    assert(Found.Count == 3 && C[G.idOf("A")] == C[G.idOf("C")]);
+    assert(C[G.idOf("D")] == C[G.idOf("E")] && C[G.idOf("A")] != C[G.idOf("D")]);
+    vector<vector<int>> Dag = G.condensation(Found);
+    assert(Dag[C[G.idOf("A")]] == vector<int>(1, C[G.idOf("D")]));
+    assert(Dag[C[G.idOf("D")]].empty() && Dag[C[G.idOf("F")]].empty());
+    if (Algorithm != SccAlgorithm::ForwardBackward)
+      assert(C[G.idOf("A")] < C[G.idOf("D")] && "edges go to larger numbers");
+  }
+
+  Graph G1;
+  if (!G1.readFile("graph1.txt"))
+    return;
+  assert(G1.stronglyConnected().Count == G1.verticesSize() && "no cycles");
+  Graph U(false);
+  if (!U.readFile("graph1.txt"))
+    return;
+  assert(U.stronglyConnected(SccAlgorithm::Kosaraju).Count == 2 &&
+         "connected components of undirected graphs");
+
+  // a long path closed into a cycle, and many small cycles, large enough
+  // for the parallel search to color before handing over to tarjan
+  Graph Big;
+  unsigned Seed = 99;
+  vector<tuple<string, string, int>> NewEdges;
+  const int Size = 40000;
+  for (int I = 0; I + 1 < Size / 2; ++I)
+    NewEdges.emplace_back("P" + to_string(I), "P" + to_string(I + 1), 1);
+  NewEdges.emplace_back("P" + to_string(Size / 2 - 1), "P0", 1);
+  for (int I = 0; I < Size; ++I) {
+    int To = nextRandom(Seed, Size / 2);
+    NewEdges.emplace_back("S" + to_string(I / 3 * 3 + (I + 1) % 3),
+                          "S" + to_string(I), 1);
+    NewEdges.emplace_back("S" + to_string(I), "S" + to_string(To), 1);
+  }
+  Big.addEdges(NewEdges);
+  Components Tarjan = Big.stronglyConnected(SccAlgorithm::Tarjan);
+  assert(samePartition(Tarjan, Big.stronglyConnected(SccAlgorithm::Kosaraju)));
+  for (int Threads : {1, 4})
+    assert(samePartition(Tarjan, Big.freeze().stronglyConnected(Threads)) &&
+           "parallel finds the same components");
+  vector<vector<int>> Dag = Big.condensation(Tarjan);
+  for (int From = 0; From < Dag.size(); ++From) {
+    for (int To : Dag[From])
+      assert(To > From && "condensation in order");
+  }
+  cout << "testStronglyConnected (PASSED)" << endl;
+}
+
+// test counters and timers, whether or not they are compiled in
+void testStats() {
+  cout << "testStats" << endl;
+  resetGraphStats();
+  Graph G;
+  G.connect("A", "B", 1);
+  G.connect("B", "C", 2);
+  G.connect("A", "C", 5);
+  Tester::resetSs();
+  G.bfs("A", Tester::labelVisitor);
+  G.dijkstra(G.idOf("A"));
+  // counts of a thread that has ended are kept
+  thread Worker([&G]() { G.dfs(0, Tester::idVisitor); });
+  Worker.join();
+  GraphStats Stats = graphStats();
+#ifdef GRAPH_INSTRUMENTATION
+  assert(Stats.VerticesAdded == 3 && Stats.EdgesAdded == 3);
+  assert(Stats.LabelLookups == 8 && "two per connect, bfs and idOf");
+  assert(Stats.VerticesVisited == 6 && Stats.EdgesScanned == 6);
+  assert(Stats.VerticesSettled == 3 && Stats.EdgesRelaxed == 3);
+  assert(Stats.HeapPushes == 4 && "start and each relaxed edge");
+  assert(Stats.Connect.Calls == 3 && Stats.Traversal.Calls == 2);
+  assert(Stats.ShortestPath.Calls == 1 && Stats.Mst.Calls == 0);
+  assert(Stats.toJson().find("\"EdgesRelaxed\": 3") != string::npos);
+  assert(Stats.toJson().find("\"Traversal\": {\"Calls\": 2") !=
+         string::npos);
+  resetGraphStats();
+  assert(graphStats().VerticesAdded == 0 && "counts start again");
+  G.connect("C", "D");
+  assert(graphStats().VerticesAdded == 1 && graphStats().EdgesAdded == 1);
+  // a range and a visitor stopped at the same vertex count the same
+  G.connect("C", "E");
+  auto Stopped = [&G](bool UseRange) {
+    resetGraphStats();
+    vector<VertexId> Seen;
+    if (UseRange) {
+      for (VertexId V : G.bfsRange(0)) {
+        Seen.push_back(V);
+        if (Seen.size() == 2)
+          break;
+      }
+    } else {
+      G.bfs(0, [&Seen](VertexId V) {
+        Seen.push_back(V);
+        return Seen.size() == 2 ? VisitResult::Stop : VisitResult::Continue;
+      });
+    }
+    assert(Seen == vector<VertexId>({0, 1}));
+    return make_pair(graphStats().VerticesVisited, graphStats().EdgesScanned);
+  };
+  assert(Stopped(true) == Stopped(false) && Stopped(false).first == 2);
+  // reading a file is not also timed as connecting its edges
+  resetGraphStats();
+  Graph FromFile;
+  if (FromFile.readFile("graph1.txt")) {
+    assert(graphStats().ReadFile.Calls == 1 &&
+           graphStats().Connect.Calls == 0);
+  }
+#else
+  assert(Stats.LabelLookups == 0 && Stats.Connect.Calls == 0 &&
+         "compiled out");
+  assert(Stats.toJson().find("\"LabelLookups\": 0") != string::npos);
+#endif
+  cout << "testStats (PASSED)" << endl;
+}
+
+// test lambdas as visitors, pruning and stopping, and lazy ranges
+void testVisitors() {
+  cout << "testVisitors" << endl;
+  Graph G;
+  if (!G.readFile("graph1.txt"))
+    return;
+  string Order;
+  G.dfs("A", [&Order](const string &Label) { Order += Label; });
+  assert(Order == "ABCDEFGH" && "capturing lambda");
+  Order.clear();
+  G.dfs("A", [&Order](const string &Label) {
+    Order += Label;
+    return Label == "D" ? VisitResult::Prune : VisitResult::Continue;
+  });
+  assert(Order == "ABCDHG" && "nothing past D");
+  Order.clear();
+  G.dfs("A", [&Order](const string &Label) {
+    Order += Label;
+    return Label == "E" ? VisitResult::Stop : VisitResult::Continue;
+  });
+  assert(Order == "ABCDE" && "dfs stops at E");
+  Order.clear();
+  G.bfs("A", [&Order](const string &Label) {
+    Order += Label;
+    return Label == "B" ? VisitResult::Prune : VisitResult::Continue;
+  });
+  assert(Order == "ABHG" && "nothing past B");
+  Order.clear();
+  G.bfs("A", [&Order](const string &Label) {
+    Order += Label;
+    return Label == "C" ? VisitResult::Stop : VisitResult::Continue;
+  });
+  assert(Order == "ABHC" && "bfs stops at C");
+  int Reached = 0;
+  G.bfs(G.idOf("X"), [&Reached](VertexId /*Id*/) { Reached++; });
+  assert(Reached == 2 && "id visitor");
+
+  // ranges give the same order as the traversals
+  Order.clear();
+  for (VertexId Id : G.bfsRange("A"))
+    Order += G.labelOf(Id);
+  assert(Order == "ABHCGDEF" && "bfs range");
+  Order.clear();
+  for (VertexId Id : G.dfsRange(G.idOf("A")))
+    Order += G.labelOf(Id);
+  assert(Order == "ABCDEFGH" && "dfs range");
+  Order.clear();
+  DfsRange Pruned = G.dfsRange("A");
+  for (VertexId Id : Pruned) {
+    Order += G.labelOf(Id);
+    if (G.labelOf(Id) == "D")
+      Pruned.prune();
+  }
+  assert(Order == "ABCDHG" && "dfs range pruned at D");
+  Order.clear();
+  BfsRange Early = G.bfsRange("A");
+  for (VertexId Id : Early) {
+    Order += G.labelOf(Id);
+    if (Order.size() == 3)
+      break;
+  }
+  assert(Order == "ABH" && !Early.done() && "rest not visited");
+  BfsRange Missing = G.bfsRange("Z");
+  assert(Missing.done() && Missing.begin() == Missing.end());
+
+  Graph Undirected(false);
+  if (!Undirected.readFile("graph0.txt"))
+    return;
+  int Weights = 0;
+  assert(Undirected.mst("A", [&Weights](const string & /*From*/,
+                                        const string & /*To*/, int Weight) {
+    Weights += Weight;
+    return VisitResult::Stop;
+  }) == 4);
+  assert(Weights == 1 && "only the first edge visited");
+  cout << "testVisitors (PASSED)" << endl;
+}
+
+// test snapshots with other weight types
+void testWeightedCsr() {
+  cout << "testWeightedCsr" << endl;
+  Graph G;
+  if (!G.readFile("graph1.txt"))
+    return;
+  const VertexId A = G.idOf("A");
+  auto Expected = G.dijkstra(A);
+  auto Wide = G.freezeAs<int32_t>().shortestPaths(A);
+  auto Narrow = G.freezeAs<uint8_t>().shortestPaths(A);
+  for (VertexId V = 0; V < G.verticesSize(); ++V) {
+    int64_t Dist = Expected.first[V] == UNREACHABLE
+                       ? WeightTraits<int32_t>::unreachable()
+                       : Expected.first[V];
+    assert(Wide.first[V] == Dist && Narrow.first[V] == Dist);
+    assert(Wide.second[V] == Expected.second[V]);
+  }
+  assert(G.freezeAs<uint8_t>().memoryBytes() <
+             G.freezeAs<int64_t>().memoryBytes() &&
+         "narrow weights take less room");
+  assert(G.freezeAs<Unweighted>().memoryBytes() ==
+             (G.verticesSize() + 1 + G.edgesSize()) * sizeof(int) &&
+         "no weights kept");
+  auto Hops = G.freezeAs<Unweighted>().shortestPaths(A);
+  assert(Hops.first[G.idOf("G")] == 2 && Hops.second[G.idOf("G")] ==
+                                             G.idOf("H") &&
+         "fewest edges, not lightest");
+  assert(Hops.first[G.idOf("X")] == UNREACHABLE);
+  assert(G.freezeAs<double>().shortestPaths(NO_VERTEX).first.empty());
+
+  // sums that do not fit in an int
+  Graph Long;
+  Long.connect("A", "B", 2000000000);
+  Long.connect("B", "C", 2000000000);
+  assert(Long.freezeAs<int32_t>().shortestPaths(0).first[2] == 4000000000LL);
+  // every int engine reports sums it cannot hold instead of wrapping them
+  assert(overflows([&Long]() { Long.dijkstra(0); }) && "too long for an int");
+  assert(overflows([&Long]() { Long.freeze().dijkstra(0); }));
+  vector<VertexId> Ids;
+  assert(overflows([&]() { Long.shortestPath(0, 2, Ids); }));
+  // A* adds the estimate to the distance as well, D cannot reach C so any
+  // estimate for it is allowed
+  Graph Search;
+  Search.connect("A", "B", 2000000000);
+  Search.connect("B", "C", 1);
+  Search.connect("A", "D", 2000000000);
+  auto Estimate = [](VertexId V) { return V == 3 ? 1000000000 : 0; };
+  assert(Search.shortestPath(0, 2, Ids) == 2000000001);
+  assert(overflows([&]() { Search.shortestPath(0, 2, Ids, Estimate); }));
+  VersionedGraph LongVersions;
+  LongVersions.connect("A", "B", 2000000000);
+  LongVersions.connect("B", "C", 2000000000);
+  LongVersions.publish();
+  assert(overflows([&]() { LongVersions.snapshot()->dijkstra(0); }));
+  Graph Repaired;
+  Repaired.connect("A", "B", 2000000000);
+  DynamicPaths Tracked(Repaired);
+  assert(Tracked.track("A"));
+  assert(overflows([&]() { Tracked.connect("B", "C", 2000000000); }));
+  assert(overflows([&]() { Tracked.paths("A"); }) && "still too long");
+  Repaired.setWeight("B", "C", 1);
+  assert(Tracked.paths("A")->first[2] == 2000000001 && "recomputed");
+  Graph LongTree(false);
+  LongTree.connect("A", "B", 2000000000);
+  LongTree.connect("B", "C", 2000000000);
+  assert(LongTree.mst("A", Tester::edgeVisitor) == 4000000000LL);
+  assert(LongTree.freeze().mst("A", Tester::edgeVisitor) == 4000000000LL);
+
+  // weights that do not fit the type are refused, not wrapped
+  Graph Heavy;
+  Heavy.connect("A", "B", 300);
+  bool Refused = false;
+  try {
+    Heavy.freezeAs<uint8_t>();
+  } catch (const out_of_range &) {
+    Refused = true;
+  }
+  assert(Refused && "300 does not fit in uint8_t");
+  assert(Heavy.freezeAs<int16_t>().shortestPaths(0).first[1] == 300);
+  assert(weightFits<int8_t>(-128) && !weightFits<uint32_t>(-1) &&
+         !weightFits<float>(1e39) && weightFits<double>(0.1));
+
+  // fractional weights read from a file
+  const string Filename = "test-weighted.txt";
+  {
+    ofstream Output(Filename);
+    Output << "4\nA B 0.25\nB C 0.5\nA C 1\nC C 2\n";
+  }
+  WeightedCsr<double> Fractional;
+  vector<string> Labels;
+  assert(Fractional.readFile(Filename, false, Labels));
+  remove(Filename.c_str());
+  assert(Labels == vector<string>({"A", "B", "C"}));
+  assert(Fractional.edgesSize() == 6 && "loop skipped, both ways");
+  assert(Fractional.shortestPaths(2).first[0] == 0.75);
+  assert(Fractional.mst(0) == 0.75);
+  assert(!Fractional.readFile("missing.txt", false, Labels));
+  {
+    ofstream Output(Filename);
+    Output << "2\nA B 200\nB C 300\n";
+  }
+  WeightedCsr<uint8_t> Small;
+  assert(!Small.readFile(Filename, true, Labels) && "300 is too heavy");
+  remove(Filename.c_str());
+  assert(Small.verticesSize() == 0 && Labels.size() == 3 && "unchanged");
+  // a line that does not parse, or a file with fewer lines than counted,
+  // is refused rather than cut short
+  for (const string Text : {"3\nA B 1\nB C x\nC D 2\n", "3\nA B 1\n", "x\n"}) {
+    {
+      ofstream Output(Filename);
+      Output << Text;
+    }
+    WeightedCsr<int> Broken;
+    assert(!Broken.readFile(Filename, true, Labels) && "malformed file");
+    assert(Broken.verticesSize() == 0 && Labels.size() == 3 && "unchanged");
+  }
+  remove(Filename.c_str());
+
+  Graph Undirected(false);
+  if (!Undirected.readFile("graph0.txt"))
+    return;
+  assert(Undirected.freezeAs<float>().mst(0) == 4.0);
+  assert(Undirected.freezeAs<Unweighted>().mst(0) == 2);
+  assert(Undirected.freezeAs<int64_t>().mst(NO_VERTEX) == -1);
+  cout << "testWeightedCsr (PASSED)" << endl;
+}
+
+// test versions of a graph read while the writer changes it
+void testVersionedGraph() {
+  cout << "testVersionedGraph" << endl;
+  VersionedGraph Versions;
+  Graph G;
+  auto Empty = Versions.snapshot();
+  assert(Empty->version() == 0 && Empty->verticesSize() == 0);
+  for (auto E : {make_tuple("A", "B", 1), make_tuple("B", "C", 1),
+                 make_tuple("C", "D", 1), make_tuple("D", "E", 1),
+                 make_tuple("E", "F", 1), make_tuple("F", "G", 1),
+                 make_tuple("A", "H", 3), make_tuple("H", "G", 1),
+                 make_tuple("X", "Y", 10)}) {
+    assert(Versions.connect(get<0>(E), get<1>(E), get<2>(E)) ==
+           G.connect(get<0>(E), get<1>(E), get<2>(E)));
+  }
+  assert(!Versions.connect("A", "B", 5) && !Versions.connect("A", "A"));
+  assert(Versions.snapshot() == Empty && "not seen before publish");
+  assert(Versions.publish() == 1);
+  auto First = Versions.snapshot();
+  assert(First->version() == 1 && First->edgesSize() == G.edgesSize());
+  for (const string Label : {"A", "B", "H", "X", "Z"}) {
+    assert(First->getEdgesAsString(Label) == G.getEdgesAsString(Label));
+    assert(First->idOf(Label) == G.idOf(Label));
+  }
+  assert(First->dijkstra(0) == G.dijkstra(0) && "same paths and ties");
+  string Order;
+  First->bfs("A", [&Order](const string &Label) { Order += Label; });
+  assert(Order == "ABHCGDEF" && "same order as Graph::bfs");
+
+  // readers keep their version while the next one is written
+  assert(Versions.disconnect("A", "H") && !Versions.disconnect("A", "H"));
+  assert(Versions.connect("A", "I", 2) && Versions.add("J"));
+  assert(Versions.publish() == 2);
+  auto Second = Versions.snapshot();
+  assert(First->getEdgesAsString("A") == "B(1),H(3)" && !First->contains("I"));
+  assert(Second->getEdgesAsString("A") == "B(1),I(2)");
+  assert(Second->verticesSize() == 12 && Second->neighborsSize("J") == 0);
+  assert(Second->getEdgesAsString("X") == "Y(10)" && "unchanged");
+  // only the vertices that changed are copied, the others are shared
+  assert(&First->labelOf(First->idOf("X")) ==
+         &Second->labelOf(Second->idOf("X")));
+  assert(&First->labelOf(0) != &Second->labelOf(0) && "A was changed");
+
+  // enough vertices for several levels of both tries, every version keeps
+  // its own ids
+  VersionedGraph Many;
+  const int Count = 40000;
+  for (int I = 0; I < Count; ++I) {
+    Many.connect("V" + to_string(I), "V" + to_string(I / 2), I);
+    if (I % 10000 == 0)
+      Many.publish();
+  }
+  Many.publish();
+  auto Early = Many.snapshot();
+  Many.connect("V" + to_string(Count - 1), "New", 1);
+  Many.publish();
+  for (int I = 0; I < Count; I += 7) {
+    const string Label = "V" + to_string(I);
+    assert(Early->labelOf(Early->idOf(Label)) == Label);
+    assert(Many.snapshot()->idOf(Label) == Early->idOf(Label));
+  }
+  assert(!Early->contains("New") && Many.snapshot()->contains("New"));
+  assert(Early->neighborsSize("V39999") == 1 &&
+         Many.snapshot()->neighborsSize("V39999") == 2);
+
+  // a version is freed when the last reader lets go
+  weak_ptr<const GraphSnapshot> Old = First;
+  First.reset();
+  assert(Old.expired());
+
+  VersionedGraph Undirected(false);
+  Undirected.connect("A", "B", 4);
+  Undirected.publish();
+  assert(Undirected.snapshot()->getEdgesAsString("B") == "A(4)");
+  assert(Undirected.snapshot()->edgesSize() == 2);
+
+  // a chain grows one edge per version, every version a reader sees is
+  // a whole chain from V0
+  VersionedGraph Chain;
+  Chain.add("V0");
+  Chain.publish();
+  const int Length = 300;
+  thread Reader([&Chain, Length]() {
+    int Seen = 0;
+    while (Seen < Length) {
+      auto Version = Chain.snapshot();
+      int Reached = 0;
+      Version->bfs(0, [&Reached](VertexId /*Id*/) { Reached++; });
+      assert(Reached == Version->edgesSize() + 1);
+      assert(Version->dijkstra(0).first.back() == Version->edgesSize());
+      Seen = Version->edgesSize();
+    }
+  });
+  for (int I = 0; I < Length; ++I) {
+    Chain.connect("V" + to_string(I), "V" + to_string(I + 1), 1);
+    Chain.publish();
+  }
+  Reader.join();
+  cout << "testVersionedGraph (PASSED)" << endl;
+}
+
+// test building a graph from several threads
+void testConcurrentBuilder() {
+  cout << "testConcurrentBuilder" << endl;
+  // the same random edges, with repeats, split between threads
+  vector<tuple<string, string, int>> Edges = randomEdges(20000, 500, 0, 7);
+  for (auto &Edge : Edges) {
+    // repeats have the same weight, whichever thread adds them first
+    get<2>(Edge) = (stoi(get<0>(Edge).substr(1)) +
+                    stoi(get<1>(Edge).substr(1))) % 9;
+  }
+  for (bool Directional : {true, false}) {
+    Graph Expected(Directional);
+    Expected.addEdges(Edges);
+    ConcurrentGraphBuilder Builder(Directional, 16);
+    Builder.add("Alone");
+    atomic<int> Connected(0);
+    vector<thread> Workers;
+    for (int T = 0; T < 4; ++T) {
+      Workers.emplace_back([&Edges, &Builder, &Connected, Directional, T]() {
+        for (int I = T; I < Edges.size(); I += 4) {
+          // undirected edges come both ways from different threads
+          bool Turned = !Directional && T % 2 == 1;
+          const string &From = get<0>(Edges[I]);
+          const string &To = get<1>(Edges[I]);
+          if (Builder.connect(Turned ? To : From, Turned ? From : To,
+                              get<2>(Edges[I])))
+            Connected++;
+        }
+      });
+    }
+    for (auto &Worker : Workers)
+      Worker.join();
+    assert(Builder.verticesSize() == Expected.verticesSize() + 1);
+    assert(Builder.edgesSize() == Expected.edgesSize());
+    Graph G(Directional);
+    assert(Builder.addTo(G, 2) == Connected);
+    assert(Builder.verticesSize() == 0 && "builder emptied");
+    assert(G.verticesSize() == Expected.verticesSize() + 1);
+    assert(G.edgesSize() == Expected.edgesSize() && G.contains("Alone"));
+    for (VertexId V = 0; V < Expected.verticesSize(); ++V) {
+      const string &Label = Expected.labelOf(V);
+      assert(G.getEdgesAsString(Label) == Expected.getEdgesAsString(Label));
+    }
+  }
+  // edges already in the graph are skipped, as by addEdges
+  Graph G;
+  G.connect("A", "B", 5);
+  ConcurrentGraphBuilder Builder;
+  assert(Builder.connect("A", "B", 1) && Builder.connect("B", "C", 2));
+  assert(!Builder.connect("A", "B", 3) && !Builder.connect("C", "C"));
+  assert(Builder.addTo(G) == 1);
+  assert(G.getEdgesAsString("A") == "B(5)" && G.getEdgesAsString("B") == "C(2)");
+  // repeats from a vertex with many edges are still found
+  ConcurrentGraphBuilder Hub(true);
+  for (int I = 0; I < 2000; ++I)
+    assert(Hub.connect("Hub", "V" + to_string(I), I));
+  for (int I = 0; I < 2000; I += 7)
+    assert(!Hub.connect("Hub", "V" + to_string(I), 0));
+  assert(Hub.edgesSize() == 2000);
+  // a graph directed the other way gets nothing
+  Graph Undirected(false);
+  assert(Hub.addTo(Undirected) == -1);
+  assert(Undirected.verticesSize() == 0 && Hub.edgesSize() == 2000);
+  Graph Directed(true);
+  assert(Hub.addTo(Directed) == 2000 && Directed.edgesSize() == 2000);
+  cout << "testConcurrentBuilder (PASSED)" << endl;
+}
+
+// check every distance against dijkstra and every kept path against the
+// edges of the graph
+static void sameAsDijkstraAll(const Graph &G, const DistanceMatrix &Paths) {
+  assert(Paths.Size == G.verticesSize());
+  for (VertexId From = 0; From < G.verticesSize(); ++From) {
+    vector<int> Dist = G.dijkstra(From).first;
+    for (VertexId To = 0; To < G.verticesSize(); ++To) {
+      assert(Paths.distance(From, To) == Dist[To]);
+      if (Paths.Prev.empty() || Dist[To] == UNREACHABLE)
+        continue;
+      vector<VertexId> Path = Paths.path(From, To);
+      assert(Path.front() == From && Path.back() == To);
+      int Length = 0;
+      for (int I = 1; I < Path.size(); ++I) {
+        int Weight =
+            edgeWeightOf(G, G.labelOf(Path[I - 1]), G.labelOf(Path[I]));
+        assert(Weight >= 0 && "path follows edges");
+        Length += Weight;
+      }
+      assert(Length == Dist[To] && "path is as long as the distance");
+    }
+  }
+}
+
+// test all pairs shortest paths with both engines
+void testAllPairs() {
+  cout << "testAllPairs" << endl;
+  const vector<ApspAlgorithm> Engines = {
+      ApspAlgorithm::Auto, ApspAlgorithm::FloydWarshall, ApspAlgorithm::Johnson};
+  for (const string Name : {"graph0.txt", "graph1.txt", "graph2.txt",
+                            "graph3.txt", "graph4.txt"}) {
+    for (bool Directional : {true, false}) {
+      Graph G(Directional);
+      if (!G.readFile(Name))
+        return;
+      for (ApspAlgorithm Engine : Engines) {
+        for (bool KeepPrevious : {false, true}) {
+          DistanceMatrix Paths;
+          assert(G.allPairs(Paths, Engine, KeepPrevious, 2));
+          assert(Paths.Prev.empty() != KeepPrevious);
+          sameAsDijkstraAll(G, Paths);
+        }
+      }
+    }
+  }
+
+  // more than one block, with random weights
+  Graph Random;
+  for (const auto &Edge : randomEdges(800, 100, 19, 3))
+    Random.connect(get<0>(Edge), get<1>(Edge), get<2>(Edge));
+  for (ApspAlgorithm Engine : Engines) {
+    DistanceMatrix Paths;
+    assert(Random.allPairs(Paths, Engine, true));
+    sameAsDijkstraAll(Random, Paths);
+  }
+
+  // negative edges, the shortest path to C goes through the negative edge
+  Graph Negative;
+  Negative.connect("A", "B", 4);
+  Negative.connect("A", "C", 2);
+  Negative.connect("B", "C", -3);
+  Negative.connect("C", "D", 1);
+  for (ApspAlgorithm Engine : Engines) {
+    DistanceMatrix Paths;
+    assert(Negative.allPairs(Paths, Engine, true));
+    assert(Paths.distance(0, 2) == 1 && Paths.distance(0, 3) == 2);
+    assert(Paths.path(0, 3) == vector<VertexId>({0, 1, 2, 3}));
+    assert(Paths.distance(3, 0) == UNREACHABLE && Paths.path(3, 0).empty());
+  }
+  Negative.connect("C", "B", 1);
+  DistanceMatrix Cycle;
+  assert(!Negative.allPairs(Cycle) && Cycle.Size == 0 && "negative cycle");
+
+  // weights too heavy for floyd-warshall, johnson runs whatever is asked
+  Graph Heavy;
+  Heavy.connect("A", "B", 400000000);
+  Heavy.connect("B", "C", -300000000);
+  Heavy.connect("C", "D", 900000000);
+  for (ApspAlgorithm Engine : Engines) {
+    DistanceMatrix Paths;
+    assert(Heavy.allPairs(Paths, Engine));
+    assert(Paths.Stride == Paths.Size && "johnson does not pad rows");
+    assert(Paths.distance(0, 3) == 1000000000);
+    assert(Paths.distance(3, 0) == UNREACHABLE);
+  }
+  // distances past an int are an error, not a wrapped number
+  Heavy.connect("D", "E", 2000000000);
+  DistanceMatrix TooFar;
+  bool Thrown = false;
+  try {
+    Heavy.allPairs(TooFar);
+  } catch (const overflow_error &) {
+    Thrown = true;
+  }
+  assert(Thrown && TooFar.Size == 0 && "A to E is over 2^31");
+  cout << "testAllPairs (PASSED)" << endl;
+}
+
 // function to call all test functions
 void testAll() {
   testGraphBasic();
@@ -261,4 +1816,27 @@ void testAll() {
   testGraph0Dijkstra();
   testGraph0NotDirected();
   testGraph1();
+  testGraph2And4Dijkstra();
+  testGraphIds();
+  testCsrGraph();
+  testDeltaStepping();
+  testParallelBfs();
+  testCsrGraphFile();
+  testDfsOrder();
+  testConcurrentQueries();
+  testBulkEdges();
+  testReadFileParallel();
+  testMemoryUsage();
+  testMst();
+  testPathQueries();
+  testShortestPath();
+  testInEdges();
+  testStats();
+  testDynamicPaths();
+  testStronglyConnected();
+  testVisitors();
+  testWeightedCsr();
+  testVersionedGraph();
+  testConcurrentBuilder();
+  testAllPairs();
 }
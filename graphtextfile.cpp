@@ -0,0 +1,338 @@
+/**
+ * Parallel reader for the text edge list format used by Graph::readFile
+ * The file is mapped, cut into chunks at line breaks, and the chunks are
+ * scanned by several threads at once
+ * Every edge lands at its position in the file, so the graph built is the
+ * same as the one readFile builds
+ *
+ * @author Bill Zhao
+ * @date updated on 10/17/2026
+ */
+
+#include "graph.h"
+#include "graphstats.h"
+#include "threadpool.h"
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <limits>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <tuple>
+#include <unistd.h>
+#include <unordered_set>
+
+using namespace std;
+
+namespace {
+
+// chunks smaller than this are not worth giving to another thread
+const int64_t MIN_CHUNK_BYTES = 1 << 16;
+
+// a read-only mapping of a whole file, unmapped when destroyed
+struct MappedText {
+  const char *Begin = nullptr;
+  size_t Length = 0;
+  ~MappedText() {
+    if (Length > 0)
+      munmap(const_cast<char *>(Begin), Length);
+  }
+};
+
+// map the file, an empty file maps to an empty range
+bool mapText(const string &Filename, MappedText &Text) {
+  int File = open(Filename.c_str(), O_RDONLY);
+  if (File == -1)
+    return false;
+  struct stat Info;
+  if (fstat(File, &Info) != 0) {
+    close(File);
+    return false;
+  }
+  if (Info.st_size > 0) {
+    void *Address =
+        mmap(nullptr, Info.st_size, PROT_READ, MAP_PRIVATE, File, 0);
+    if (Address == MAP_FAILED) {
+      close(File);
+      return false;
+    }
+    madvise(Address, Info.st_size, MADV_SEQUENTIAL);
+    Text.Begin = static_cast<const char *>(Address);
+    Text.Length = Info.st_size;
+  }
+  close(File);
+  return true;
+}
+
+// same characters as the whitespace skipped by operator>>
+bool isSpace(char C) {
+  return C == ' ' || C == '\t' || C == '\r' || C == '\v' || C == '\f';
+}
+
+// the words of one line, at most three, and whether there were more
+struct LineWords {
+  const char *Word[3];
+  const char *WordEnd[3];
+  int Count = 0;
+  bool TooMany = false;
+};
+
+// split the line [Begin, End) into words separated by whitespace
+LineWords splitLine(const char *Begin, const char *End) {
+  LineWords Words;
+  const char *At = Begin;
+  while (true) {
+    while (At < End && isSpace(*At))
+      ++At;
+    if (At == End)
+      return Words;
+    if (Words.Count == 3) {
+      Words.TooMany = true;
+      return Words;
+    }
+    Words.Word[Words.Count] = At;
+    while (At < End && !isSpace(*At))
+      ++At;
+    Words.WordEnd[Words.Count++] = At;
+  }
+}
+
+// read an int from all of [Begin, End), with an optional sign
+// @return false if it is not a number or does not fit in an int
+bool scanInt(const char *Begin, const char *End, int &Value) {
+  bool Negative = false;
+  if (Begin < End && (*Begin == '-' || *Begin == '+')) {
+    Negative = *Begin == '-';
+    ++Begin;
+  }
+  if (Begin == End)
+    return false;
+  const int64_t Limit = static_cast<int64_t>(numeric_limits<int>::max()) +
+                        (Negative ? 1 : 0);
+  int64_t Result = 0;
+  for (const char *At = Begin; At < End; ++At) {
+    if (*At < '0' || *At > '9')
+      return false;
+    Result = Result * 10 + (*At - '0');
+    if (Result > Limit)
+      return false;
+  }
+  Value = static_cast<int>(Negative ? -Result : Result);
+  return true;
+}
+
+// @return the end of the line starting at Begin, before its '\n'
+const char *lineEnd(const char *Begin, const char *End) {
+  const char *NewLine =
+      static_cast<const char *>(memchr(Begin, '\n', End - Begin));
+  return NewLine == nullptr ? End : NewLine;
+}
+
+// @return true if the line has nothing but whitespace
+bool isBlank(const char *Begin, const char *End) {
+  return all_of(Begin, End, isSpace);
+}
+
+// what the first pass learns about a chunk
+struct ChunkCounts {
+  // lines that start in the chunk
+  int64_t Lines = 0;
+  // lines that are not blank
+  int64_t Edges = 0;
+};
+
+// first error found in a chunk
+struct ChunkError {
+  int64_t Line = numeric_limits<int64_t>::max();
+  string Message;
+};
+
+} // namespace
+
+// read the edge list with several threads, see the header for the format
+bool Graph::readFileParallel(const string &Filename, int Threads,
+                             string *Error) {
+  GRAPH_TIMER(ReadFile);
+  auto Fail = [Error](int64_t Line, const string &Message) {
+    if (Error != nullptr)
+      *Error = Line > 0 ? "line " + to_string(Line) + ": " + Message : Message;
+    return false;
+  };
+  MappedText Text;
+  if (!mapText(Filename, Text))
+    return Fail(0, "cannot open " + Filename);
+  const char *Begin = Text.Begin;
+  const char *End = Text.Begin + Text.Length;
+
+  // the edge count is the first word, blank lines before it are skipped
+  int64_t Line = 1;
+  const char *At = Begin;
+  LineWords Header;
+  while (At < End) {
+    const char *Stop = lineEnd(At, End);
+    Header = splitLine(At, Stop);
+    At = Stop == End ? End : Stop + 1;
+    if (Header.Count > 0)
+      break;
+    Line++;
+  }
+  int Count = 0;
+  if (Header.Count == 0)
+    return Fail(Line, "missing number of edges");
+  if (Header.Count != 1 || Header.TooMany ||
+      !scanInt(Header.Word[0], Header.WordEnd[0], Count) || Count < 0)
+    return Fail(Line, "expected the number of edges");
+  const int64_t FirstLine = Line + 1;
+  const char *Data = At;
+
+  // cut the rest of the file into chunks that end at line breaks
+  ThreadPool Pool(Threads);
+  const int64_t DataBytes = End - Data;
+  int64_t ChunkCount = min<int64_t>(Pool.size() * 8,
+                                    DataBytes / MIN_CHUNK_BYTES + 1);
+  vector<const char *> Cuts(1, Data);
+  for (int64_t C = 1; C < ChunkCount; ++C) {
+    const char *Cut = max(Data + DataBytes * C / ChunkCount, Cuts.back());
+    Cut = lineEnd(Cut, End);
+    Cuts.push_back(Cut == End ? End : Cut + 1);
+  }
+  Cuts.push_back(End);
+  ChunkCount = static_cast<int64_t>(Cuts.size()) - 1;
+
+  // first pass counts the lines and edges in each chunk, so each chunk knows
+  // its first line number and the position of its first edge
+  vector<ChunkCounts> Counts(ChunkCount + 1);
+  Pool.parallelFor(static_cast<int>(ChunkCount),
+                   [&](int First, int Last, int /*Worker*/) {
+                     for (int C = First; C < Last; ++C) {
+                       ChunkCounts Local;
+                       for (const char *L = Cuts[C]; L < Cuts[C + 1];) {
+                         const char *Stop = lineEnd(L, Cuts[C + 1]);
+                         Local.Lines++;
+                         Local.Edges += isBlank(L, Stop) ? 0 : 1;
+                         L = Stop == End ? End : Stop + 1;
+                       }
+                       Counts[C + 1] = Local;
+                     }
+                   });
+  Counts[0].Lines = FirstLine;
+  for (int64_t C = 0; C < ChunkCount; ++C) {
+    Counts[C + 1].Lines += Counts[C].Lines;
+    Counts[C + 1].Edges += Counts[C].Edges;
+  }
+  // lines after the counted edges are comments and are not read
+  if (Counts[ChunkCount].Edges < Count)
+    return Fail(0, "file ends after " + to_string(Counts[ChunkCount].Edges) +
+                    " of " + to_string(Count) + " edges");
+
+  // second pass scans each edge into its place
+  vector<tuple<string, string, int>> FileEdges(Count);
+  vector<ChunkError> Errors(ChunkCount);
+  Pool.parallelFor(
+      static_cast<int>(ChunkCount), [&](int First, int Last, int /*Worker*/) {
+        for (int C = First; C < Last; ++C) {
+          int64_t LineNumber = Counts[C].Lines;
+          int64_t EdgeNumber = Counts[C].Edges;
+          for (const char *L = Cuts[C]; L < Cuts[C + 1] && EdgeNumber < Count;
+               ++LineNumber) {
+            const char *Stop = lineEnd(L, Cuts[C + 1]);
+            LineWords Words = splitLine(L, Stop);
+            L = Stop == End ? End : Stop + 1;
+            if (Words.Count == 0)
+              continue;
+            auto &NewEdge = FileEdges[EdgeNumber++];
+            if (Words.Count != 3 || Words.TooMany ||
+                !scanInt(Words.Word[2], Words.WordEnd[2], get<2>(NewEdge))) {
+              Errors[C] = {LineNumber, "expected \"from to weight\""};
+              break;
+            }
+            get<0>(NewEdge).assign(Words.Word[0], Words.WordEnd[0]);
+            get<1>(NewEdge).assign(Words.Word[1], Words.WordEnd[1]);
+          }
+        }
+      });
+  for (auto &Found : Errors) {
+    if (!Found.Message.empty())
+      return Fail(Found.Line, Found.Message);
+  }
+  addFileEdges(FileEdges, Pool);
+  return true;
+}
+
+// same as addEdges, but the labels are looked up and the edges added by
+// several threads
+// the labels are split into shards by hash, each shard finds the first time
+// each of its labels is used, and then only those first uses go through
+// findOrAdd, in file order, so the ids come out as addEdges gives them
+void Graph::addFileEdges(const vector<tuple<string, string, int>> &FileEdges,
+                         ThreadPool &Pool) {
+  // use U of the labels is side U % 2 of edge U / 2
+  const int64_t Uses = 2 * static_cast<int64_t>(FileEdges.size());
+  auto LabelOf = [&FileEdges](int64_t Use) -> const string & {
+    auto &FileEdge = FileEdges[Use / 2];
+    return Use % 2 == 0 ? get<0>(FileEdge) : get<1>(FileEdge);
+  };
+  vector<size_t> Hashes(Uses);
+  Pool.parallelFor(static_cast<int>(FileEdges.size()),
+                   [&](int Begin, int End, int /*Worker*/) {
+                     hash<string> Hash;
+                     for (int64_t Use = 2 * Begin; Use < 2 * End; ++Use)
+                       Hashes[Use] = Hash(LabelOf(Use));
+                   });
+
+  // the uses of each shard, in file order, so every shard only walks its own
+  const int Shards = Pool.size();
+  vector<vector<int64_t>> ShardUses(Shards);
+  for (auto &Bucket : ShardUses)
+    Bucket.reserve(Uses / Shards + 1);
+  for (int64_t Use = 0; Use < Uses; ++Use)
+    ShardUses[Hashes[Use] % Shards].push_back(Use);
+
+  // FirstUse[U] is the first use with the same label, or -1 for self-loops,
+  // which addEdges skips without adding their vertices
+  vector<int64_t> FirstUse(Uses);
+  Pool.parallelFor(Shards, [&](int Begin, int End, int /*Worker*/) {
+    auto UseHash = [&Hashes](int64_t Use) { return Hashes[Use]; };
+    auto SameLabel = [&LabelOf](int64_t A, int64_t B) {
+      return LabelOf(A) == LabelOf(B);
+    };
+    for (int Shard = Begin; Shard < End; ++Shard) {
+      unordered_set<int64_t, decltype(UseHash), decltype(SameLabel)> Seen(
+          ShardUses[Shard].size(), UseHash, SameLabel);
+      for (int64_t Use : ShardUses[Shard]) {
+        if (get<0>(FileEdges[Use / 2]) == get<1>(FileEdges[Use / 2]))
+          FirstUse[Use] = -1;
+        else
+          FirstUse[Use] = *Seen.insert(Use).first;
+      }
+      vector<int64_t>().swap(ShardUses[Shard]);
+    }
+  });
+
+  // ids of the first uses, in file order
+  vector<VertexId> Ids(Uses, NO_VERTEX);
+  for (int64_t Use = 0; Use < Uses; ++Use) {
+    if (FirstUse[Use] == Use)
+      Ids[Use] = findOrAdd(LabelOf(Use))->Id;
+  }
+  Pool.parallelFor(static_cast<int>(FileEdges.size()),
+                   [&](int Begin, int End, int /*Worker*/) {
+                     for (int64_t Use = 2 * Begin; Use < 2 * End; ++Use) {
+                       if (FirstUse[Use] >= 0 && FirstUse[Use] != Use)
+                         Ids[Use] = Ids[FirstUse[Use]];
+                     }
+                   });
+
+  vector<PendingEdge> Pending;
+  Pending.reserve(DirectionalEdges ? FileEdges.size() : Uses);
+  for (int64_t I = 0; I < FileEdges.size(); ++I) {
+    if (FirstUse[2 * I] < 0)
+      continue;
+    int Weight = get<2>(FileEdges[I]);
+    Pending.push_back({Ids[2 * I], Ids[2 * I + 1], Weight, false});
+    if (!DirectionalEdges)
+      Pending.push_back({Ids[2 * I + 1], Ids[2 * I], Weight, true});
+  }
+  addPendingEdges(Pending, &Pool);
+}
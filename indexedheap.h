@@ -0,0 +1,145 @@
+/**
+ * An IndexedHeap is a d-ary min heap of vertex ids ordered by key
+ * Every id is in the heap at most once, and its position is tracked
+ * so the key of an id in the heap can be decreased in place
+ * Ids with equal keys come out smallest id first
+ *
+ * @author Bill Zhao
+ * @date updated on 10/17/2026
+ */
+
+#ifndef INDEXEDHEAP_H
+#define INDEXEDHEAP_H
+
+#include <cassert>
+#include <vector>
+
+using namespace std;
+
+template <typename Key, int Arity = 4> class IndexedHeap {
+public:
+  // empty heap for ids 0..Capacity-1
+  explicit IndexedHeap(int Capacity)
+      : Position(Capacity, NOT_IN_HEAP), Keys(Capacity) {}
+
+  // make room for ids up to Capacity-1, ids in the heap stay where they are
+  void reserve(int Capacity) {
+    if (Capacity > static_cast<int>(Position.size())) {
+      Position.resize(Capacity, NOT_IN_HEAP);
+      Keys.resize(Capacity);
+    }
+  }
+
+  // @return true if there are no ids in the heap
+  bool empty() const { return Heap.empty(); }
+
+  // @return number of ids in the heap
+  int size() const { return static_cast<int>(Heap.size()); }
+
+  // @return true if the id is in the heap
+  bool contains(int Id) const { return Position[Id] != NOT_IN_HEAP; }
+
+  // @return key of an id that is in the heap
+  Key key(int Id) const { return Keys[Id]; }
+
+  // @return id with the smallest key, heap must not be empty
+  int top() const { return Heap.front(); }
+
+  // add an id that is not in the heap
+  void push(int Id, Key K) {
+    assert(!contains(Id));
+    Keys[Id] = K;
+    Position[Id] = size();
+    Heap.push_back(Id);
+    siftUp(Position[Id]);
+  }
+
+  // lower the key of an id that is in the heap
+  void decrease(int Id, Key K) {
+    assert(contains(Id) && !(Keys[Id] < K));
+    Keys[Id] = K;
+    siftUp(Position[Id]);
+  }
+
+  // add the id, or lower its key if it is already in the heap
+  // @return true if the id was added or its key lowered
+  bool pushOrDecrease(int Id, Key K) {
+    if (!contains(Id)) {
+      push(Id, K);
+      return true;
+    }
+    if (!(K < Keys[Id]))
+      return false;
+    decrease(Id, K);
+    return true;
+  }
+
+  // remove and return the id with the smallest key
+  int pop() {
+    int Top = Heap.front();
+    int Last = Heap.back();
+    Heap.pop_back();
+    Position[Top] = NOT_IN_HEAP;
+    if (!Heap.empty()) {
+      Heap.front() = Last;
+      Position[Last] = 0;
+      siftDown(0);
+    }
+    return Top;
+  }
+
+private:
+  enum : int { NOT_IN_HEAP = -1 };
+  // ids in heap order
+  vector<int> Heap;
+  // index into Heap for every id, NOT_IN_HEAP if the id is not in the heap
+  vector<int> Position;
+  // key for every id, only meaningful while the id is in the heap
+  vector<Key> Keys;
+
+  // true if id A should be closer to the top than id B
+  bool before(int A, int B) const {
+    return Keys[A] < Keys[B] || (!(Keys[B] < Keys[A]) && A < B);
+  }
+
+  // move the id at Pos up until its parent is smaller
+  void siftUp(int Pos) {
+    int Id = Heap[Pos];
+    while (Pos > 0) {
+      int Parent = (Pos - 1) / Arity;
+      if (!before(Id, Heap[Parent]))
+        break;
+      Heap[Pos] = Heap[Parent];
+      Position[Heap[Pos]] = Pos;
+      Pos = Parent;
+    }
+    Heap[Pos] = Id;
+    Position[Id] = Pos;
+  }
+
+  // move the id at Pos down until all its children are larger
+  void siftDown(int Pos) {
+    int Id = Heap[Pos];
+    const int Size = size();
+    while (true) {
+      int First = Pos * Arity + 1;
+      if (First >= Size)
+        break;
+      int Best = First;
+      int End = First + Arity < Size ? First + Arity : Size;
+      for (int Child = First + 1; Child < End; ++Child) {
+        if (before(Heap[Child], Heap[Best]))
+          Best = Child;
+      }
+      if (!before(Heap[Best], Id))
+        break;
+      Heap[Pos] = Heap[Best];
+      Position[Heap[Pos]] = Pos;
+      Pos = Best;
+    }
+    Heap[Pos] = Id;
+    Position[Id] = Pos;
+  }
+};
+
+#endif // INDEXEDHEAP_H
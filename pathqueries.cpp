@@ -0,0 +1,91 @@
+/**
+ * PathQueries answers batches of single source shortest path queries
+ * with a least recently used cache of results
+ *
+ * @author Bill Zhao
+ * @date updated on 10/17/2026
+ */
+
+#include "pathqueries.h"
+
+using namespace std;
+
+// empty cache for the graph's current version
+PathQueries::PathQueries(const Graph &G, int Capacity, int Threads)
+    : G(G), Pool(Threads), Capacity(Capacity), Version(G.version()) {}
+
+// answer what is cached, then run the other sources on the pool
+vector<shared_ptr<const PathQueries::Paths>>
+PathQueries::dijkstra(const vector<string> &Sources) {
+  if (G.version() != Version) {
+    clear();
+    Version = G.version();
+  }
+  vector<shared_ptr<const Paths>> Results(Sources.size());
+  // each source that is not cached is computed once, even if asked twice
+  vector<VertexId> Missing;
+  unordered_map<VertexId, vector<int>> AskedAt;
+  for (int I = 0; I < Sources.size(); ++I) {
+    VertexId Source = G.idOf(Sources[I]);
+    if (Source == NO_VERTEX)
+      continue;
+    Results[I] = lookup(Source);
+    if (Results[I] != nullptr) {
+      Hits++;
+      continue;
+    }
+    auto &Positions = AskedAt[Source];
+    if (Positions.empty()) {
+      Missing.push_back(Source);
+      Misses++;
+    }
+    Positions.push_back(I);
+  }
+
+  vector<shared_ptr<const Paths>> Computed(Missing.size());
+  Pool.parallelFor(static_cast<int>(Missing.size()),
+                   [&](int Begin, int End, int /*Worker*/) {
+                     for (int I = Begin; I < End; ++I)
+                       Computed[I] =
+                           make_shared<const Paths>(G.dijkstra(Missing[I]));
+                   });
+  for (int I = 0; I < Missing.size(); ++I) {
+    for (int Position : AskedAt[Missing[I]])
+      Results[Position] = Computed[I];
+    insert(Missing[I], Computed[I]);
+  }
+  return Results;
+}
+
+// a batch of one
+shared_ptr<const PathQueries::Paths>
+PathQueries::dijkstra(const string &Source) {
+  return dijkstra(vector<string>(1, Source)).front();
+}
+
+// forget all results, the counters are kept
+void PathQueries::clear() {
+  Recent.clear();
+  Cached.clear();
+}
+
+// move a cached result to the front
+shared_ptr<const PathQueries::Paths> PathQueries::lookup(VertexId Source) {
+  auto Found = Cached.find(Source);
+  if (Found == Cached.end())
+    return nullptr;
+  Recent.splice(Recent.begin(), Recent, Found->second);
+  return Found->second->second;
+}
+
+// add at the front, dropping from the back
+void PathQueries::insert(VertexId Source, shared_ptr<const Paths> Result) {
+  if (Capacity <= 0)
+    return;
+  if (Recent.size() == Capacity) {
+    Cached.erase(Recent.back().first);
+    Recent.pop_back();
+  }
+  Recent.emplace_front(Source, move(Result));
+  Cached[Source] = Recent.begin();
+}
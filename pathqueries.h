@@ -0,0 +1,76 @@
+/**
+ * PathQueries answers batches of single source shortest path queries
+ * on a graph, running the sources of a batch on a thread pool
+ * Results are kept in a least recently used cache by source, and the whole
+ * cache is dropped when the graph's version changes, so asking again for
+ * the same source of an unchanged graph is only a lookup
+ * One batch runs at a time, and the graph must not change during a batch
+ *
+ * @author Bill Zhao
+ * @date updated on 10/17/2026
+ */
+
+#ifndef PATHQUERIES_H
+#define PATHQUERIES_H
+
+#include "graph.h"
+#include "threadpool.h"
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+class PathQueries {
+public:
+  // distances and previous vertices indexed by id, as Graph::dijkstra
+  using Paths = pair<vector<int>, vector<VertexId>>;
+
+  // queries on G, keeping the results of up to Capacity sources
+  // Threads is the size of the pool, 0 or less for one per core
+  explicit PathQueries(const Graph &G, int Capacity = 1024, int Threads = 0);
+
+  PathQueries(const PathQueries &) = delete;
+  PathQueries &operator=(const PathQueries &) = delete;
+
+  // shortest paths from each source, in the order of Sources
+  // sources that are not in the graph get nullptr
+  // results stay valid after they are dropped from the cache
+  vector<shared_ptr<const Paths>> dijkstra(const vector<string> &Sources);
+
+  // shortest paths from one source, nullptr if it is not in the graph
+  shared_ptr<const Paths> dijkstra(const string &Source);
+
+  // @return number of sources answered from the cache and computed
+  uint64_t hits() const { return Hits; }
+  uint64_t misses() const { return Misses; }
+
+  // @return number of sources in the cache
+  int size() const { return static_cast<int>(Recent.size()); }
+
+  // forget all results
+  void clear();
+
+private:
+  const Graph &G;
+  ThreadPool Pool;
+  int Capacity;
+  // graph version the cached results were computed at
+  uint64_t Version;
+  // most recently used source first
+  list<pair<VertexId, shared_ptr<const Paths>>> Recent;
+  unordered_map<VertexId, decltype(Recent)::iterator> Cached;
+  uint64_t Hits = 0;
+  uint64_t Misses = 0;
+
+  // @return cached result moved to the front, nullptr if not cached
+  shared_ptr<const Paths> lookup(VertexId Source);
+  // cache a result, dropping the least recently used one when full
+  void insert(VertexId Source, shared_ptr<const Paths> Result);
+};
+
+#endif // PATHQUERIES_H
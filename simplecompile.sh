@@ -77,7 +77,7 @@ echo "*** compiling with $CC to create an executable called myprogram"
 echo "==================================================================="
 
 $CC --version
-$CC -std=c++14 -Wall -Wextra -Wno-sign-compare ./*.cpp -g -o myprogram
+$CC -std=c++14 -Wall -Wextra -Wno-sign-compare -pthread ./*.cpp -g -o myprogram
 
 echo "==================================================================="
 # Check if file myprogram exists or not, execute it if it exists
@@ -155,7 +155,7 @@ fi
 
 echo "==================================================================="
 echo "*** compiling with $CC to checking for memory leaks"
-$CC -std=c++14 -fsanitize=address -fno-omit-frame-pointer -g ./*.cpp -o myprogram
+$CC -std=c++14 -fsanitize=address -fno-omit-frame-pointer -pthread -g ./*.cpp -o myprogram
 
 echo "==================================================================="
 if [ -f myprogram ]; then
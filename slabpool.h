@@ -0,0 +1,94 @@
+/**
+ * A SlabPool hands out objects of one type from large blocks of memory
+ * Blocks grow in size as the pool fills, and are only given back when the
+ * pool is destroyed, so many small objects cost no malloc calls each
+ * Destroyed objects go on a free list and their slots are reused first
+ * The pool does not run destructors of objects still in use when it is
+ * destroyed, owners must destroy objects that need it
+ * Not thread safe
+ *
+ * @author Bill Zhao
+ * @date updated on 10/17/2026
+ */
+
+#ifndef SLABPOOL_H
+#define SLABPOOL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+template <typename T> class SlabPool {
+public:
+  SlabPool() = default;
+  SlabPool(const SlabPool &) = delete;
+  SlabPool &operator=(const SlabPool &) = delete;
+
+  // construct an object in a free slot, or in a new block if there is none
+  template <typename... Args> T *create(Args &&...Arguments) {
+    void *Place;
+    if (FreeList != nullptr) {
+      Place = FreeList;
+      FreeList = FreeList->Next;
+    } else {
+      if (Used == BlockSize)
+        grow();
+      Place = &Blocks.back()[Used++];
+    }
+    Live++;
+    return new (Place) T(forward<Args>(Arguments)...);
+  }
+
+  // destroy the object and keep its slot for the next create
+  void destroy(T *Object) {
+    Object->~T();
+    Slot *Freed = reinterpret_cast<Slot *>(Object);
+    Freed->Next = FreeList;
+    FreeList = Freed;
+    Live--;
+  }
+
+  // @return number of objects created and not destroyed
+  size_t size() const { return Live; }
+
+  // @return number of slots in all blocks, used or not
+  size_t capacity() const { return Capacity; }
+
+  // @return bytes taken by all blocks
+  size_t bytes() const { return Capacity * sizeof(Slot); }
+
+private:
+  // a slot holds an object, or the next free slot once it is destroyed
+  union Slot {
+    Slot *Next;
+    alignas(T) unsigned char Storage[sizeof(T)];
+  };
+
+  // the first block is small so small graphs stay small, later blocks
+  // double up to a limit so the waste at the end stays bounded
+  enum : size_t { FIRST_BLOCK = 32, LARGEST_BLOCK = 1 << 16 };
+
+  vector<unique_ptr<Slot[]>> Blocks;
+  Slot *FreeList = nullptr;
+  // slots in the last block and how many of them were handed out
+  size_t BlockSize = 0;
+  size_t Used = 0;
+  size_t Capacity = 0;
+  size_t Live = 0;
+
+  // start a new block, larger than the last one
+  void grow() {
+    BlockSize = BlockSize == 0 ? FIRST_BLOCK
+                            : min<size_t>(2 * BlockSize, LARGEST_BLOCK);
+    Blocks.emplace_back(new Slot[BlockSize]);
+    Used = 0;
+    Capacity += BlockSize;
+  }
+};
+
+#endif // SLABPOOL_H
@@ -0,0 +1,90 @@
+/**
+ * A ThreadPool keeps a fixed set of worker threads for parallel loops
+ * The thread calling parallelFor also does work, as worker 0
+ *
+ * @author Bill Zhao
+ * @date updated on 10/17/2026
+ */
+
+#include "threadpool.h"
+#include <algorithm>
+
+using namespace std;
+
+// start Threads - 1 background workers, the caller is the last one
+ThreadPool::ThreadPool(int Threads) {
+  if (Threads <= 0)
+    Threads = max(1, static_cast<int>(thread::hardware_concurrency()));
+  for (int Worker = 1; Worker < Threads; ++Worker)
+    Workers.emplace_back(&ThreadPool::workerLoop, this, Worker);
+}
+
+// stop and join all workers
+ThreadPool::~ThreadPool() {
+  {
+    lock_guard<mutex> Guard(Lock);
+    Stopping = true;
+  }
+  WorkReady.notify_all();
+  for (auto &Worker : Workers)
+    Worker.join();
+}
+
+// get the number of threads, including the calling thread
+int ThreadPool::size() const { return static_cast<int>(Workers.size()) + 1; }
+
+// run the loop on all threads and wait for it to finish
+void ThreadPool::parallelFor(
+    int Count, const function<void(int Begin, int End, int Worker)> &Task) {
+  if (Count <= 0)
+    return;
+  if (Workers.empty() || Count == 1) {
+    Task(0, Count, 0);
+    return;
+  }
+  {
+    lock_guard<mutex> Guard(Lock);
+    this->Task = &Task;
+    this->Count = Count;
+    // several chunks per thread so uneven chunks balance out
+    ChunkSize = max(1, Count / (size() * 8));
+    NextChunk = 0;
+    Running = static_cast<int>(Workers.size());
+    Generation++;
+  }
+  WorkReady.notify_all();
+  runChunks(0);
+  unique_lock<mutex> Guard(Lock);
+  WorkDone.wait(Guard, [this] { return Running == 0; });
+  this->Task = nullptr;
+}
+
+// background worker, runs every loop started after it was created
+void ThreadPool::workerLoop(int Worker) {
+  long Seen = 0;
+  while (true) {
+    {
+      unique_lock<mutex> Guard(Lock);
+      WorkReady.wait(Guard, [&] { return Stopping || Generation != Seen; });
+      if (Stopping)
+        return;
+      Seen = Generation;
+    }
+    runChunks(Worker);
+    {
+      lock_guard<mutex> Guard(Lock);
+      Running--;
+    }
+    WorkDone.notify_one();
+  }
+}
+
+// take the next chunk until the loop is used up
+void ThreadPool::runChunks(int Worker) {
+  while (true) {
+    int Begin = NextChunk.fetch_add(ChunkSize);
+    if (Begin >= Count)
+      return;
+    (*Task)(Begin, min(Count, Begin + ChunkSize), Worker);
+  }
+}
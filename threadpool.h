@@ -0,0 +1,65 @@
+/**
+ * A ThreadPool keeps a fixed set of worker threads for parallel loops
+ * The thread calling parallelFor also does work, as worker 0
+ * parallelFor calls are not reentrant: only one loop runs at a time
+ *
+ * @author Bill Zhao
+ * @date updated on 10/17/2026
+ */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+class ThreadPool {
+public:
+  // pool with the given number of threads, 0 or less for one per core
+  explicit ThreadPool(int Threads = 0);
+
+  /** destructor, stop and join all worker threads */
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  // @return number of threads, including the calling thread
+  int size() const;
+
+  // split [0, Count) into chunks and call Task(Begin, End, Worker) on each
+  // Worker is between 0 and size() - 1, and no two chunks given to the same
+  // Worker run at the same time, so it can index per-thread buffers
+  // returns once every chunk is done
+  void parallelFor(int Count,
+                   const function<void(int Begin, int End, int Worker)> &Task);
+
+private:
+  vector<thread> Workers;
+  mutex Lock;
+  condition_variable WorkReady;
+  condition_variable WorkDone;
+  bool Stopping = false;
+  // increases by one for every parallelFor, wakes up the workers
+  long Generation = 0;
+  // number of background workers still running the current loop
+  int Running = 0;
+  // the current loop
+  const function<void(int, int, int)> *Task = nullptr;
+  int Count = 0;
+  int ChunkSize = 1;
+  atomic<int> NextChunk{0};
+
+  // wait for loops and run them until the pool is stopped
+  void workerLoop(int Worker);
+  // take chunks of the current loop until there are none left
+  void runChunks(int Worker);
+};
+
+#endif // THREADPOOL_H
@@ -0,0 +1,93 @@
+/**
+ * Lazy bfs and dfs ranges, each step does the work of the traversal up to
+ * the next vertex
+ *
+ * @author Bill Zhao
+ * @date updated on 10/17/2026
+ */
+
+#include "traversal.h"
+#include "graph.h"
+#include "graphstats.h"
+
+using namespace std;
+
+BfsRange::BfsRange(const Graph &G, VertexId Start)
+    : Visited(G.VisitedSets.acquire(G.Vertices)) {
+  if (!G.validId(Start))
+    return;
+  Visited->mark(Start);
+  Queue.push_back(G.AllVertices[Start]);
+  GRAPH_COUNT(VerticesVisited, 1);
+}
+
+VertexId BfsRange::current() const { return Queue[Head]->Id; }
+
+// the neighbors are queued only when moving past the vertex, so prune can
+// still be called for it
+// a vertex is counted as visited when the range reaches it, where
+// Graph::bfs calls its visitor, so stopping early counts the same
+void BfsRange::next() {
+  Vertex *Curr = Queue[Head++];
+  if (Pruned) {
+    Pruned = false;
+  } else {
+    GRAPH_COUNT(EdgesScanned, Curr->Neighbors.size());
+    for (auto &Neighbor : Curr->Neighbors) {
+      if (Visited->visit(Neighbor->To->Id))
+        Queue.push_back(Neighbor->To);
+    }
+  }
+  if (!done())
+    GRAPH_COUNT(VerticesVisited, 1);
+}
+
+DfsRange::DfsRange(const Graph &G, VertexId Start)
+    : Visited(G.VisitedSets.acquire(G.Vertices)) {
+  if (!G.validId(Start))
+    return;
+  Visited->mark(Start);
+  Stack.emplace_back(G.AllVertices[Start], 0);
+  GRAPH_COUNT(VerticesVisited, 1);
+}
+
+// the current vertex is always the top of the stack
+VertexId DfsRange::current() const { return Stack.back().first->Id; }
+
+void DfsRange::next() {
+  if (Pruned) {
+    Stack.back().second = static_cast<int>(Stack.back().first->Neighbors.size());
+    Pruned = false;
+  }
+  while (!Stack.empty()) {
+    Vertex *Curr = Stack.back().first;
+    int Next = Stack.back().second++;
+    if (Next == Curr->Neighbors.size()) {
+      Stack.pop_back();
+      continue;
+    }
+    Vertex *Neighbor = Curr->Neighbors[Next]->To;
+    GRAPH_COUNT(EdgesScanned, 1);
+    if (Visited->visit(Neighbor->Id)) {
+      Stack.emplace_back(Neighbor, 0);
+      GRAPH_COUNT(VerticesVisited, 1);
+      return;
+    }
+  }
+}
+
+BfsRange Graph::bfsRange(const string &StartLabel) const {
+  return BfsRange(*this, idOf(StartLabel));
+}
+
+BfsRange Graph::bfsRange(VertexId Start) const {
+  return BfsRange(*this, Start);
+}
+
+DfsRange Graph::dfsRange(const string &StartLabel) const {
+  return DfsRange(*this, idOf(StartLabel));
+}
+
+DfsRange Graph::dfsRange(VertexId Start) const {
+  return DfsRange(*this, Start);
+}
@@ -0,0 +1,136 @@
+/**
+ * Visitors that can stop a traversal, and traversals as lazy ranges
+ * A visitor may return a VisitResult: Continue goes on as usual, Prune
+ * does not follow the edges of the vertex just visited, and Stop ends
+ * the traversal. A visitor that returns nothing always continues
+ * BfsRange and DfsRange find the next vertex only when asked for it, so a
+ * loop that breaks out early does not walk the rest of the graph
+ * The graph must not change while a range is used
+ *
+ * @author Bill Zhao
+ * @date updated on 10/17/2026
+ */
+
+#ifndef TRAVERSAL_H
+#define TRAVERSAL_H
+
+#include "vertex.h"
+#include "visitedpool.h"
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+class Graph;
+
+// what a visitor wants the traversal to do next
+enum class VisitResult { Continue, Prune, Stop };
+
+// call a visitor, a visitor that returns nothing continues
+template <typename Visitor, typename... Args>
+auto visitResult(Visitor &Visit, Args &&...Arguments) ->
+    typename enable_if<is_void<decltype(Visit(forward<Args>(Arguments)...))>::value,
+                       VisitResult>::type {
+  Visit(forward<Args>(Arguments)...);
+  return VisitResult::Continue;
+}
+
+template <typename Visitor, typename... Args>
+auto visitResult(Visitor &Visit, Args &&...Arguments) ->
+    typename enable_if<!is_void<decltype(Visit(forward<Args>(Arguments)...))>::value,
+                       VisitResult>::type {
+  return Visit(forward<Args>(Arguments)...);
+}
+
+// input iterator over the ids of a BfsRange or DfsRange
+// iterators of the same range all move together, as the range is consumed
+template <typename Range> class TraversalIterator {
+public:
+  using iterator_category = input_iterator_tag;
+  using value_type = VertexId;
+  using difference_type = ptrdiff_t;
+  using pointer = const VertexId *;
+  using reference = VertexId;
+
+  // past the end, when Traversal is nullptr
+  explicit TraversalIterator(Range *Traversal = nullptr)
+      : Traversal(Traversal) {}
+  VertexId operator*() const { return Traversal->current(); }
+  TraversalIterator &operator++() {
+    Traversal->next();
+    return *this;
+  }
+  // only tells if both have or have not reached the end
+  bool operator==(const TraversalIterator &Other) const {
+    return ended() == Other.ended();
+  }
+  bool operator!=(const TraversalIterator &Other) const {
+    return !(*this == Other);
+  }
+
+private:
+  Range *Traversal;
+  bool ended() const { return Traversal == nullptr || Traversal->done(); }
+};
+
+// vertices reachable from a start vertex, nearest first, in the same order
+// as Graph::bfs
+class BfsRange {
+  friend class Graph;
+
+public:
+  using Iterator = TraversalIterator<BfsRange>;
+  Iterator begin() { return Iterator(this); }
+  Iterator end() { return Iterator(); }
+
+  // @return true when every reachable vertex has been visited
+  bool done() const { return Head == Queue.size(); }
+
+  // @return id of the vertex the range is at, range must not be done
+  VertexId current() const;
+
+  // move to the next vertex, adding the neighbors of the current one to
+  // the queue unless it was pruned
+  void next();
+
+  // do not follow the edges of the current vertex
+  void prune() { Pruned = true; }
+
+private:
+  VisitedPool::Lease Visited;
+  vector<Vertex *> Queue;
+  size_t Head = 0;
+  bool Pruned = false;
+  // empty range if Start is not a vertex of G
+  BfsRange(const Graph &G, VertexId Start);
+};
+
+// vertices reachable from a start vertex, in the same order as Graph::dfs
+class DfsRange {
+  friend class Graph;
+
+public:
+  using Iterator = TraversalIterator<DfsRange>;
+  Iterator begin() { return Iterator(this); }
+  Iterator end() { return Iterator(); }
+
+  bool done() const { return Stack.empty(); }
+  VertexId current() const;
+  // move to the next vertex not visited yet, going back up the path to
+  // the current vertex as needed
+  void next();
+  // do not go deeper from the current vertex
+  void prune() { Pruned = true; }
+
+private:
+  VisitedPool::Lease Visited;
+  // path to the current vertex, each with the index of its next neighbor
+  vector<pair<Vertex *, int>> Stack;
+  bool Pruned = false;
+  DfsRange(const Graph &G, VertexId Start);
+};
+
+#endif // TRAVERSAL_H
@@ -0,0 +1,251 @@
+/**
+ * Versions of a graph shared between one writer and many readers
+ *
+ * @author Bill Zhao
+ * @date updated on 10/17/2026
+ */
+
+#include "versionedgraph.h"
+#include "indexedheap.h"
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+using namespace std;
+
+// follow the hash down to a leaf, then look through its few labels
+VertexId GraphSnapshot::idOf(const string &Label) const {
+  const size_t Hash = hash<string>()(Label);
+  const IndexNode *Node = Index.get();
+  for (int Level = 0; Node != nullptr && !Node->Children.empty(); ++Level)
+    Node = Node->Children[childOf(Hash, Level)].get();
+  if (Node == nullptr)
+    return NO_VERTEX;
+  for (const IndexEntry &Entry : Node->Entries) {
+    if (Entry.Hash == Hash && Entry.Label == Label)
+      return Entry.Id;
+  }
+  return NO_VERTEX;
+}
+
+const string &GraphSnapshot::labelOf(VertexId Id) const {
+  if (!validId(Id))
+    throw out_of_range("no vertex with id " + to_string(Id));
+  return vertexOf(Id).Label;
+}
+
+// the highest bits of the id pick the child of the root
+const GraphSnapshot::VertexNode &GraphSnapshot::vertexOf(VertexId Id) const {
+  const TableNode *Node = Table.get();
+  for (int Level = Height; Level > 0; --Level)
+    Node = Node->Children[childOf(Id, Level)].get();
+  return *Node->Vertices[childOf(Id, 0)];
+}
+
+bool GraphSnapshot::contains(const string &Label) const {
+  return idOf(Label) != NO_VERTEX;
+}
+
+int GraphSnapshot::neighborsSize(const string &Label) const {
+  VertexId Id = idOf(Label);
+  return Id == NO_VERTEX ? -1 : static_cast<int>(neighborsOf(Id).size());
+}
+
+// same format as Graph::getEdgesAsString
+string GraphSnapshot::getEdgesAsString(const string &Label) const {
+  VertexId Id = idOf(Label);
+  string Ans;
+  if (Id == NO_VERTEX)
+    return Ans;
+  for (const Adjacent &Neighbor : neighborsOf(Id)) {
+    if (!Ans.empty())
+      Ans += ",";
+    Ans += labelOf(Neighbor.To) + "(" + to_string(Neighbor.Weight) + ")";
+  }
+  return Ans;
+}
+
+// dijkstra with an indexed heap, as Graph::dijkstra
+pair<vector<int>, vector<VertexId>>
+GraphSnapshot::dijkstra(VertexId Start) const {
+  vector<int> Dist(Vertices, UNREACHABLE);
+  vector<VertexId> Prev(Vertices, NO_VERTEX);
+  if (!validId(Start))
+    return make_pair(Dist, Prev);
+  auto Done = VisitedSets->acquire(Vertices);
+  IndexedHeap<int> Queue(Vertices);
+  Dist[Start] = 0;
+  Queue.push(Start, 0);
+  while (!Queue.empty()) {
+    VertexId Curr = Queue.pop();
+    Done->mark(Curr);
+    for (const Adjacent &Neighbor : neighborsOf(Curr)) {
+      int NewDist = pathLength(Dist[Curr], Neighbor.Weight);
+      if (!Done->seen(Neighbor.To) && NewDist < Dist[Neighbor.To]) {
+        Dist[Neighbor.To] = NewDist;
+        Prev[Neighbor.To] = Curr;
+        Queue.pushOrDecrease(Neighbor.To, NewDist);
+      }
+    }
+  }
+  return make_pair(Dist, Prev);
+}
+
+// version 0 has an empty table and an empty index
+VersionedGraph::VersionedGraph(bool DirectionalEdges) {
+  Pending.DirectionalEdges = DirectionalEdges;
+  Pending.VisitedSets = make_shared<VisitedPool>();
+  Pending.Table = newNode<GraphSnapshot::TableNode>();
+  Pending.Index = newNode<GraphSnapshot::IndexNode>();
+  publish();
+}
+
+shared_ptr<const GraphSnapshot> VersionedGraph::snapshot() const {
+  return atomic_load(&Published);
+}
+
+bool VersionedGraph::add(const string &Label) {
+  int Before = Pending.Vertices;
+  findOrAdd(Label);
+  return Pending.Vertices > Before;
+}
+
+// same checks as Graph::connect
+bool VersionedGraph::connect(const string &From, const string &To,
+                             int Weight) {
+  if (From == To)
+    return false;
+  VertexId FromId = findOrAdd(From);
+  VertexId ToId = findOrAdd(To);
+  if (!addEdge(FromId, ToId, Weight))
+    return false;
+  if (!Pending.DirectionalEdges)
+    addEdge(ToId, FromId, Weight);
+  return true;
+}
+
+bool VersionedGraph::disconnect(const string &From, const string &To) {
+  VertexId FromId = Pending.idOf(From);
+  VertexId ToId = Pending.idOf(To);
+  if (FromId == NO_VERTEX || ToId == NO_VERTEX || !removeEdge(FromId, ToId))
+    return false;
+  if (!Pending.DirectionalEdges)
+    removeEdge(ToId, FromId);
+  return true;
+}
+
+// readers already holding a version keep it, the nodes of Pending become
+// shared with the new version, only the two roots are copied
+uint64_t VersionedGraph::publish() {
+  atomic_store(&Published, make_shared<const GraphSnapshot>(Pending));
+  return Pending.Version++;
+}
+
+template <typename Node> shared_ptr<Node> VersionedGraph::newNode() const {
+  auto Made = make_shared<Node>();
+  Made->Version = Pending.Version;
+  return Made;
+}
+
+template <typename Node>
+Node &VersionedGraph::writable(shared_ptr<Node> &Slot) {
+  if (Slot->Version != Pending.Version) {
+    Slot = make_shared<Node>(*Slot);
+    Slot->Version = Pending.Version;
+  }
+  return *Slot;
+}
+
+// nodes under the table are made when the first id below them is added
+shared_ptr<GraphSnapshot::VertexNode> &
+VersionedGraph::vertexSlot(VertexId Id) {
+  shared_ptr<GraphSnapshot::TableNode> *Slot = &Pending.Table;
+  for (int Level = Pending.Height; Level > 0; --Level) {
+    GraphSnapshot::TableNode &Node = writable(*Slot);
+    const size_t Child = GraphSnapshot::childOf(Id, Level);
+    if (!Node.Children[Child])
+      Node.Children[Child] = newNode<GraphSnapshot::TableNode>();
+    Slot = &Node.Children[Child];
+  }
+  GraphSnapshot::TableNode &Lowest = writable(*Slot);
+  const size_t Child = GraphSnapshot::childOf(Id, 0);
+  if (!Lowest.Vertices[Child])
+    Lowest.Vertices[Child] = newNode<GraphSnapshot::VertexNode>();
+  return Lowest.Vertices[Child];
+}
+
+// a full leaf becomes an inner node and its labels move one level down
+void VersionedGraph::addToIndex(shared_ptr<GraphSnapshot::IndexNode> &Slot,
+                                int Level, GraphSnapshot::IndexEntry Entry) {
+  if (!Slot)
+    Slot = newNode<GraphSnapshot::IndexNode>();
+  GraphSnapshot::IndexNode &Node = writable(Slot);
+  if (Node.Children.empty()) {
+    if (Node.Entries.size() < GraphSnapshot::LEAF_SIZE ||
+        Level == GraphSnapshot::INDEX_LEVELS) {
+      Node.Entries.push_back(move(Entry));
+      return;
+    }
+    vector<GraphSnapshot::IndexEntry> Moved;
+    Moved.swap(Node.Entries);
+    Node.Children.resize(GraphSnapshot::FANOUT);
+    for (auto &Old : Moved)
+      addToIndex(Node.Children[GraphSnapshot::childOf(Old.Hash, Level)],
+                 Level + 1, move(Old));
+  }
+  addToIndex(Node.Children[GraphSnapshot::childOf(Entry.Hash, Level)],
+             Level + 1, move(Entry));
+}
+
+// a full table gets a new root with the old one as its first child
+VertexId VersionedGraph::findOrAdd(const string &Label) {
+  VertexId Id = Pending.idOf(Label);
+  if (Id != NO_VERTEX)
+    return Id;
+  Id = Pending.Vertices++;
+  const int Bits = GraphSnapshot::FANOUT_BITS * (Pending.Height + 1);
+  const int64_t Capacity = int64_t{1} << Bits;
+  if (Id == Capacity) {
+    auto Root = newNode<GraphSnapshot::TableNode>();
+    Root->Children[0] = Pending.Table;
+    Pending.Table = Root;
+    Pending.Height++;
+  }
+  vertexSlot(Id)->Label = Label;
+  addToIndex(Pending.Index, 0, {hash<string>()(Label), Label, Id});
+  return Id;
+}
+
+// add a single directed edge, keeping neighbors sorted by label
+bool VersionedGraph::addEdge(VertexId From, VertexId To, int Weight) {
+  for (const auto &Neighbor : Pending.neighborsOf(From)) {
+    if (Neighbor.To == To)
+      return false;
+  }
+  const string &ToLabel = Pending.labelOf(To);
+  auto &Neighbors = writable(vertexSlot(From)).Neighbors;
+  auto Position =
+      upper_bound(Neighbors.begin(), Neighbors.end(), ToLabel,
+                  [this](const string &Label,
+                         const GraphSnapshot::Adjacent &Neighbor) {
+                    return Label < Pending.labelOf(Neighbor.To);
+                  });
+  Neighbors.insert(Position, {To, Weight});
+  Pending.Edges++;
+  return true;
+}
+
+bool VersionedGraph::removeEdge(VertexId From, VertexId To) {
+  const auto &Shared = Pending.neighborsOf(From);
+  auto Found = find_if(Shared.begin(), Shared.end(),
+                       [To](const GraphSnapshot::Adjacent &Neighbor) {
+                         return Neighbor.To == To;
+                       });
+  if (Found == Shared.end())
+    return false;
+  const auto Position = Found - Shared.begin();
+  auto &Neighbors = writable(vertexSlot(From)).Neighbors;
+  Neighbors.erase(Neighbors.begin() + Position);
+  Pending.Edges--;
+  return true;
+}
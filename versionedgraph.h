@@ -0,0 +1,224 @@
+/**
+ * A VersionedGraph lets one writer change a graph while any number of
+ * readers query it
+ * Readers pin a GraphSnapshot, which never changes, and keep reading it
+ * while the writer prepares the next version. publish makes the writer's
+ * changes visible to readers that take a snapshot afterwards
+ * The vertex table and the label index are tries shared between
+ * versions, each node made by the writer for the next version is changed
+ * in place until that version is published and copied after, so a change
+ * copies one vertex and the few nodes on the way to it, whatever the size
+ * of the graph
+ * Versions, and nodes no version uses, are freed once the last reader
+ * holding them lets go
+ *
+ * @author Bill Zhao
+ * @date updated on 10/17/2026
+ */
+
+#ifndef VERSIONEDGRAPH_H
+#define VERSIONEDGRAPH_H
+
+#include "traversal.h"
+#include "vertex.h"
+#include "visitedpool.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// one version of a VersionedGraph, it can be read by several threads at once
+// ids, edge order and results are the same as for a Graph built with the
+// same calls
+class GraphSnapshot {
+  friend class VersionedGraph;
+
+public:
+  // @return number of times the graph was published before this version
+  uint64_t version() const { return Version; }
+
+  // @return total number of vertices
+  int verticesSize() const { return Vertices; }
+
+  // @return total number of edges, undirected edges count twice
+  int edgesSize() const { return Edges; }
+
+  // @return id of the vertex, NO_VERTEX if vertex not found
+  VertexId idOf(const string &Label) const;
+
+  // @return label of the vertex with the given id, throws if id is not valid
+  const string &labelOf(VertexId Id) const;
+
+  // @return true if vertex is in the graph
+  bool contains(const string &Label) const;
+
+  // @return number of edges from given vertex, -1 if vertex not found
+  int neighborsSize(const string &Label) const;
+
+  // @return string representing edges and weights, "" if vertex not found
+  string getEdgesAsString(const string &Label) const;
+
+  // breadth-first traversal, Visit may return a VisitResult as for
+  // Graph::bfs
+  template <typename Visitor>
+  void bfs(const string &StartLabel, Visitor &&Visit) const;
+  template <typename Visitor> void bfs(VertexId Start, Visitor &&Visit) const;
+
+  // same as Graph::dijkstra, overflow_error included
+  pair<vector<int>, vector<VertexId>> dijkstra(VertexId Start) const;
+
+private:
+  // ids and label hashes pick a child FANOUT_BITS bits at a time, index
+  // leaves hold up to LEAF_SIZE labels, and only leaves INDEX_LEVELS down,
+  // where the hash bits run out, hold more
+  enum : int {
+    FANOUT_BITS = 5,
+    FANOUT = 1 << FANOUT_BITS,
+    LEAF_SIZE = 8,
+    INDEX_LEVELS = 12
+  };
+  struct Adjacent {
+    VertexId To;
+    int Weight;
+  };
+  // every node keeps the version it was made for
+  struct VertexNode {
+    uint64_t Version = 0;
+    string Label;
+    // edges sorted by the label they go to
+    vector<Adjacent> Neighbors;
+  };
+  // node of the vertex table, the lowest level holds the vertices, slots
+  // past the last id are nullptr
+  struct TableNode {
+    uint64_t Version = 0;
+    array<shared_ptr<TableNode>, FANOUT> Children;
+    array<shared_ptr<VertexNode>, FANOUT> Vertices;
+  };
+  struct IndexEntry {
+    size_t Hash;
+    string Label;
+    VertexId Id;
+  };
+  // node of the label index, a leaf until it is split, children of an
+  // inner node are nullptr when no label leads there
+  struct IndexNode {
+    uint64_t Version = 0;
+    vector<shared_ptr<IndexNode>> Children;
+    vector<IndexEntry> Entries;
+  };
+
+  bool DirectionalEdges = true;
+  int Vertices = 0;
+  int Edges = 0;
+  uint64_t Version = 0;
+  // levels of the table above the lowest one
+  int Height = 0;
+  shared_ptr<TableNode> Table;
+  shared_ptr<IndexNode> Index;
+  // shared by all versions of the graph
+  shared_ptr<VisitedPool> VisitedSets;
+
+  bool validId(VertexId Id) const { return Id >= 0 && Id < Vertices; }
+  const VertexNode &vertexOf(VertexId Id) const;
+  const vector<Adjacent> &neighborsOf(VertexId Id) const {
+    return vertexOf(Id).Neighbors;
+  }
+  // child of the node Level levels down taken by a hash or an id
+  static size_t childOf(size_t Key, int Level) {
+    return (Key >> (Level * FANOUT_BITS)) & (FANOUT - 1);
+  }
+  template <typename VisitVertex>
+  void bfsFrom(VertexId Start, VisitVertex Visit) const;
+};
+
+class VersionedGraph {
+public:
+  // empty graph, published as version 0
+  explicit VersionedGraph(bool DirectionalEdges = true);
+
+  VersionedGraph(const VersionedGraph &) = delete;
+  VersionedGraph &operator=(const VersionedGraph &) = delete;
+
+  // latest published version, safe to call from any thread
+  shared_ptr<const GraphSnapshot> snapshot() const;
+
+  // the rest may only be called by one thread at a time, the writer
+  // changes are not seen by readers until publish
+
+  // same as Graph::add
+  bool add(const string &Label);
+
+  // same as Graph::connect
+  bool connect(const string &From, const string &To, int Weight = 0);
+
+  // same as Graph::disconnect
+  bool disconnect(const string &From, const string &To);
+
+  // make the changes so far the latest version
+  // @return the new version
+  uint64_t publish();
+
+private:
+  // the next version, sharing nodes with the published one, nodes whose
+  // version is Pending.Version are not published yet
+  GraphSnapshot Pending;
+  // only read and written with atomic_load and atomic_store
+  shared_ptr<const GraphSnapshot> Published;
+
+  // new node for the next version
+  template <typename Node> shared_ptr<Node> newNode() const;
+  // node in Slot, copied first if a published version may be using it
+  template <typename Node> Node &writable(shared_ptr<Node> &Slot);
+  // slot of the vertex, making the table nodes above it writable and
+  // adding the vertex if Id is the next id
+  shared_ptr<GraphSnapshot::VertexNode> &vertexSlot(VertexId Id);
+  // add the label to the part of the index below Slot
+  void addToIndex(shared_ptr<GraphSnapshot::IndexNode> &Slot, int Level,
+                  GraphSnapshot::IndexEntry Entry);
+  // id of the vertex, adding it if it is not in the graph
+  VertexId findOrAdd(const string &Label);
+  bool addEdge(VertexId From, VertexId To, int Weight);
+  bool removeEdge(VertexId From, VertexId To);
+};
+
+template <typename Visitor>
+void GraphSnapshot::bfs(const string &StartLabel, Visitor &&Visit) const {
+  VertexId Start = idOf(StartLabel);
+  if (Start != NO_VERTEX)
+    bfsFrom(Start, [this, &Visit](VertexId Curr) {
+      return visitResult(Visit, labelOf(Curr));
+    });
+}
+
+template <typename Visitor>
+void GraphSnapshot::bfs(VertexId Start, Visitor &&Visit) const {
+  if (validId(Start))
+    bfsFrom(Start,
+            [&Visit](VertexId Curr) { return visitResult(Visit, Curr); });
+}
+
+// same order as Graph::bfs
+template <typename VisitVertex>
+void GraphSnapshot::bfsFrom(VertexId Start, VisitVertex Visit) const {
+  auto Visited = VisitedSets->acquire(Vertices);
+  Visited->mark(Start);
+  vector<VertexId> Queue(1, Start);
+  for (int I = 0; I < Queue.size(); ++I) {
+    VisitResult Result = visitResult(Visit, Queue[I]);
+    if (Result == VisitResult::Stop)
+      return;
+    if (Result == VisitResult::Prune)
+      continue;
+    for (const Adjacent &Neighbor : neighborsOf(Queue[I])) {
+      if (Visited->visit(Neighbor.To))
+        Queue.push_back(Neighbor.To);
+    }
+  }
+}
+
+#endif // VERSIONEDGRAPH_H
@@ -1,12 +1,9 @@
 /**
  * A Graph is made up of Vertex objects that hold data values
  * A vertex is connected to other vertices via Edges
- * A vertex can be visited/unvisited
  * Can connect to another vertex via directed edge with weight
  * The edge can be disconnected
  * A vertex cannot have an edge back to itself
- * getNextNeighbor returns the next neighbor each time it is called
- * when there are no more neighbors, the vertex label is returned
  *
  * @author Bill Zhao
  * @date updated on 2/5/2020
@@ -16,36 +13,57 @@
 #define VERTEX_H
 
 #include "edge.h"
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
 
 using namespace std;
 
+// vertices are numbered in the order they are added to the graph
+using VertexId = int;
+// id used when there is no vertex, such as the previous of the start vertex
+const VertexId NO_VERTEX = -1;
+// distance given to vertices that cannot be reached in dense distance arrays
+const int UNREACHABLE = numeric_limits<int>::max();
+
+// Dist + Weight for the int distances of the shortest path engines, added
+// in 64 bits and throwing overflow_error if it does not fit in an int below
+// UNREACHABLE, so a long path is never taken for a short one
+inline int pathLength(int Dist, int Weight) {
+  const int64_t Length = static_cast<int64_t>(Dist) + Weight;
+  if (Length >= UNREACHABLE || Length < numeric_limits<int>::min())
+    throw overflow_error("path length does not fit in an int");
+  return static_cast<int>(Length);
+}
+
 class Vertex {
   friend class Graph;
+  friend class BfsRange;
+  friend class CsrGraph;
+  friend class DfsRange;
+  friend class DynamicPaths;
   friend class Edge;
   friend ostream &operator<<(ostream &Os, const Vertex &V);
 
 public:
-  /** Creates an unvisited vertex, gives it a label, and clears its
+  /** Creates a vertex, gives it a label, and clears its
       adjacency list.
       NOTE: A vertex must have a unique label that cannot be changed. */
   explicit Vertex(const string &Label);
   /** Destructor. Delete all edges from this vertex to other vertices */
   ~Vertex();
-  // get the next neighbor
-  string next();
   // get the weight of the weight connected to the given vertex on the other side
   int edgeWeight(string const& To) const;
   string Label; // NOLINT
   // make it public for simplicity
 
 private:
-  bool Seen = false;       // boolean check if this vertex is seen
-  int Index = 0;           // integer to track the location of the index
-                           // for next neighbor
+  VertexId Id = 0;         // position of this vertex in the graph
   vector<Edge*> Neighbors; // all neighbors of this vertex
+  vector<Edge*> InEdges;   // edges into this vertex, when the graph keeps them
 };
 
 #endif  //  ASS3_GRAPHS_VERTEX_H
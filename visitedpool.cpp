@@ -0,0 +1,55 @@
+/**
+ * A VisitedSet marks the vertices seen by one traversal
+ * A VisitedPool hands out VisitedSets and reuses them between traversals
+ *
+ * @author Bill Zhao
+ * @date updated on 10/17/2026
+ */
+
+#include "visitedpool.h"
+#include <algorithm>
+
+using namespace std;
+
+// new epoch, stamps are only cleared when the epoch wraps around
+void VisitedSet::reset(int Size) {
+  if (Stamps.size() < Size)
+    Stamps.resize(Size, 0);
+  Epoch++;
+  if (Epoch == 0) {
+    fill(Stamps.begin(), Stamps.end(), 0);
+    Epoch = 1;
+  }
+}
+
+// borrow the given set
+VisitedPool::Lease::Lease(VisitedPool &Pool, unique_ptr<VisitedSet> Set)
+    : Pool(Pool), Set(move(Set)) {}
+
+// give the set back, unless it was moved to another lease
+VisitedPool::Lease::~Lease() {
+  if (Set)
+    Pool.release(move(Set));
+}
+
+// reuse a free set if there is one, otherwise make a new one
+VisitedPool::Lease VisitedPool::acquire(int Size) {
+  unique_ptr<VisitedSet> Set;
+  {
+    lock_guard<mutex> Guard(Lock);
+    if (!Free.empty()) {
+      Set = move(Free.back());
+      Free.pop_back();
+    }
+  }
+  if (!Set)
+    Set.reset(new VisitedSet());
+  Set->reset(Size);
+  return Lease(*this, move(Set));
+}
+
+// keep the set for the next traversal
+void VisitedPool::release(unique_ptr<VisitedSet> Set) {
+  lock_guard<mutex> Guard(Lock);
+  Free.push_back(move(Set));
+}
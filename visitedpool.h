@@ -0,0 +1,78 @@
+/**
+ * A VisitedSet marks the vertices seen by one traversal
+ * Instead of clearing a flag on every vertex before each traversal, a
+ * vertex is seen when its stamp equals the set's current epoch, so
+ * starting a new traversal only increments the epoch
+ * A VisitedPool hands out VisitedSets so concurrent traversals of the same
+ * graph each get their own, and reuses them between traversals
+ *
+ * @author Bill Zhao
+ * @date updated on 10/17/2026
+ */
+
+#ifndef VISITEDPOOL_H
+#define VISITEDPOOL_H
+
+#include "vertex.h"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace std;
+
+class VisitedSet {
+  friend class VisitedPool;
+
+public:
+  // @return true if the vertex has been seen in this traversal
+  bool seen(VertexId Id) const { return Stamps[Id] == Epoch; }
+
+  // mark the vertex as seen
+  void mark(VertexId Id) { Stamps[Id] = Epoch; }
+
+  // mark the vertex as seen
+  // @return true if it had not been seen before
+  bool visit(VertexId Id) {
+    if (seen(Id))
+      return false;
+    mark(Id);
+    return true;
+  }
+
+private:
+  vector<unsigned> Stamps;
+  unsigned Epoch = 0;
+  // forget all seen vertices and make room for Size vertices
+  void reset(int Size);
+};
+
+class VisitedPool {
+public:
+  // a VisitedSet borrowed from the pool, given back when destroyed
+  class Lease {
+  public:
+    Lease(VisitedPool &Pool, unique_ptr<VisitedSet> Set);
+    Lease(Lease &&Other) noexcept = default;
+    Lease &operator=(Lease &&Other) = delete;
+    ~Lease();
+    VisitedSet &operator*() const { return *Set; }
+    VisitedSet *operator->() const { return Set.get(); }
+
+  private:
+    VisitedPool &Pool;
+    unique_ptr<VisitedSet> Set;
+  };
+
+  // @return an empty VisitedSet for vertex ids 0..Size-1
+  // safe to call from several threads at once
+  Lease acquire(int Size);
+
+private:
+  mutex Lock;
+  // sets that are not in use
+  vector<unique_ptr<VisitedSet>> Free;
+  // take back a set that is no longer used
+  void release(unique_ptr<VisitedSet> Set);
+};
+
+#endif // VISITEDPOOL_H
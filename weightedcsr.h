@@ -0,0 +1,342 @@
+/**
+ * A WeightedCsr is a read-only snapshot like CsrGraph whose edge weights
+ * are of type W, chosen when the snapshot is made
+ * W can be any integer or floating point type, or Unweighted for graphs
+ * whose edges all cost the same, which keeps no weights at all
+ * Narrow weights such as uint8_t keep the edge arrays small, while path
+ * lengths are summed in WeightTraits<W>::Distance, 64 bits for integers
+ * and double for floating point, so long paths do not overflow or round
+ * The kernels are picked at compile time, unweighted shortest paths are
+ * a bfs instead of dijkstra
+ * Vertex ids are the ids of the graph the snapshot was made from
+ *
+ * @author Bill Zhao
+ * @date updated on 10/17/2026
+ */
+
+#ifndef WEIGHTEDCSR_H
+#define WEIGHTEDCSR_H
+
+#include "indexedheap.h"
+#include "vertex.h"
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// weight type of graphs whose edges all have length 1
+struct Unweighted {};
+
+// how weights of type W are stored and added up
+template <typename W> struct WeightTraits {
+  static_assert(is_arithmetic<W>::value,
+                "weights must be numbers or Unweighted");
+  static const bool HasWeights = true;
+  // length of a path, wide enough not to overflow or lose precision
+  using Distance = typename conditional<is_floating_point<W>::value, double,
+                                        int64_t>::type;
+  // type weights are read from files as, so uint8_t is not read as a char
+  using Parsed = Distance;
+  // distance of vertices that cannot be reached
+  static Distance unreachable() {
+    return numeric_limits<Distance>::has_infinity
+               ? numeric_limits<Distance>::infinity()
+               : numeric_limits<Distance>::max();
+  }
+};
+
+template <> struct WeightTraits<Unweighted> {
+  static const bool HasWeights = false;
+  // number of edges on the path
+  using Distance = int;
+  // the weight column of a file is read and ignored
+  using Parsed = double;
+  static Distance unreachable() { return UNREACHABLE; }
+};
+
+// true if Value can be kept as a W, integers must keep their exact value
+// and sign, floating point values only need to be in range
+template <typename W, typename V> bool weightFits(V Value, false_type) {
+  if (Value < 0 && !is_signed<W>::value)
+    return false;
+  return static_cast<V>(static_cast<W>(Value)) == Value;
+}
+template <typename W, typename V> bool weightFits(V Value, true_type) {
+  return !(Value > numeric_limits<W>::max() ||
+           Value < numeric_limits<W>::lowest());
+}
+template <typename W, typename V> bool weightFits(V Value) {
+  return weightFits<W>(Value, is_floating_point<W>());
+}
+
+// weight of type W for the int weight of a Graph edge
+// throws out_of_range if the weight does not fit in W
+template <typename W> W weightAs(int Weight) {
+  if (!weightFits<W>(Weight))
+    throw out_of_range("weight " + to_string(Weight) + " does not fit");
+  return static_cast<W>(Weight);
+}
+template <> inline Unweighted weightAs<Unweighted>(int /*Weight*/) {
+  return Unweighted();
+}
+
+// an edge given to the WeightedCsr constructor
+template <typename W> struct WeightedEdge {
+  VertexId From;
+  VertexId To;
+  W Weight;
+};
+
+template <typename W> class WeightedCsr {
+public:
+  using Traits = WeightTraits<W>;
+  using Distance = typename Traits::Distance;
+
+  // empty snapshot
+  WeightedCsr() : Offsets(1, 0) {}
+
+  // snapshot of the vertices 0..VertexCount-1 and the given edges, each
+  // vertex keeps its edges in the order given
+  // when Directed is false every edge also goes the other way
+  WeightedCsr(int VertexCount, const vector<WeightedEdge<W>> &Edges,
+              bool Directed = true);
+
+  // read a file in the format of Graph::readFile, with weights of type W
+  // vertices are numbered in the order they first appear, and Labels is
+  // set to the label of each id
+  // edges from a vertex to itself are skipped, repeated edges are kept
+  // as with Graph::readFileParallel, every counted line must be
+  // "from to weight", blank lines aside
+  // @return true if the file was read, false leaves the snapshot unchanged,
+  // including when a line is malformed or a weight does not fit in W
+  bool readFile(const string &Filename, bool Directed, vector<string> &Labels);
+
+  // @return total number of vertices
+  int verticesSize() const { return VertexCount; }
+
+  // @return total number of edges, undirected edges count twice
+  int edgesSize() const { return static_cast<int>(Targets.size()); }
+
+  // @return bytes used by the edge arrays, weights included
+  size_t memoryBytes() const {
+    return Offsets.size() * sizeof(int) + Targets.size() * sizeof(VertexId) +
+           Weights.size() * sizeof(W);
+  }
+
+  // shortest distance from Start to all vertices and the previous vertex on
+  // the path, dijkstra, or bfs when unweighted
+  // distance is Traits::unreachable() and previous is NO_VERTEX for
+  // unreachable vertices, both are empty if Start is not valid
+  // weights must not be negative
+  pair<vector<Distance>, vector<VertexId>> shortestPaths(VertexId Start) const {
+    return shortestPaths(Start, integral_constant<bool, Traits::HasWeights>());
+  }
+
+  // length of the minimum spanning tree of the component containing Start,
+  // for snapshots made with Directed false or from undirected graphs
+  // unweighted trees are as long as the component has vertices minus one
+  // @return -1 if Start is not valid
+  Distance mst(VertexId Start) const {
+    return mst(Start, integral_constant<bool, Traits::HasWeights>());
+  }
+
+private:
+  int VertexCount = 0;
+  // edges of vertex i are Targets[Offsets[i]] to Targets[Offsets[i + 1] - 1]
+  // with the same positions in Weights, which is empty when unweighted
+  vector<int> Offsets;
+  vector<VertexId> Targets;
+  vector<W> Weights;
+
+  bool validId(VertexId Id) const { return Id >= 0 && Id < VertexCount; }
+
+  pair<vector<Distance>, vector<VertexId>> shortestPaths(VertexId Start,
+                                                         true_type) const;
+  pair<vector<Distance>, vector<VertexId>> shortestPaths(VertexId Start,
+                                                         false_type) const;
+  Distance mst(VertexId Start, true_type) const;
+  Distance mst(VertexId Start, false_type) const;
+
+  // keep a weight, or nothing when unweighted
+  void addWeight(const W &Weight, true_type) { Weights.push_back(Weight); }
+  void addWeight(const W & /*Weight*/, false_type) {}
+  // false if the weight read does not fit in W
+  static bool toWeight(typename Traits::Parsed Value, W &Weight, true_type) {
+    if (!weightFits<W>(Value))
+      return false;
+    Weight = static_cast<W>(Value);
+    return true;
+  }
+  static bool toWeight(typename Traits::Parsed /*Value*/, W & /*Weight*/,
+                       false_type) {
+    return true;
+  }
+};
+
+// counting sort of the edges by their From vertex, keeping their order
+template <typename W>
+WeightedCsr<W>::WeightedCsr(int VertexCount,
+                            const vector<WeightedEdge<W>> &Edges,
+                            bool Directed)
+    : VertexCount(VertexCount), Offsets(VertexCount + 1, 0) {
+  const int Copies = Directed ? 1 : 2;
+  for (const auto &E : Edges) {
+    Offsets[E.From + 1]++;
+    if (!Directed)
+      Offsets[E.To + 1]++;
+  }
+  for (int V = 0; V < VertexCount; ++V)
+    Offsets[V + 1] += Offsets[V];
+  vector<int> Next(Offsets.begin(), Offsets.end() - 1);
+  Targets.resize(Edges.size() * Copies);
+  vector<const WeightedEdge<W> *> Placed(Targets.size());
+  for (const auto &E : Edges) {
+    Targets[Next[E.From]] = E.To;
+    Placed[Next[E.From]++] = &E;
+    if (!Directed) {
+      Targets[Next[E.To]] = E.From;
+      Placed[Next[E.To]++] = &E;
+    }
+  }
+  for (auto E : Placed)
+    addWeight(E->Weight, integral_constant<bool, Traits::HasWeights>());
+}
+
+template <typename W>
+bool WeightedCsr<W>::readFile(const string &Filename, bool Directed,
+                              vector<string> &Labels) {
+  ifstream Input(Filename);
+  if (!Input.is_open())
+    return false;
+  vector<string> FileLabels;
+  unordered_map<string, VertexId> Ids;
+  auto IdOf = [&FileLabels, &Ids](const string &Label) {
+    auto Found = Ids.emplace(Label, static_cast<VertexId>(FileLabels.size()));
+    if (Found.second)
+      FileLabels.push_back(Label);
+    return Found.first->second;
+  };
+  int Line = 0;
+  if (!(Input >> Line))
+    return false;
+  string FromValue;
+  string ToValue;
+  typename Traits::Parsed WeightValue;
+  vector<WeightedEdge<W>> FileEdges;
+  for (int I = 0; I < Line; ++I) {
+    if (!(Input >> FromValue >> ToValue >> WeightValue))
+      return false;
+    W Weight = W();
+    if (!toWeight(WeightValue, Weight,
+                  integral_constant<bool, Traits::HasWeights>()))
+      return false;
+    VertexId From = IdOf(FromValue);
+    VertexId To = IdOf(ToValue);
+    if (From != To)
+      FileEdges.push_back({From, To, Weight});
+  }
+  *this = WeightedCsr(static_cast<int>(FileLabels.size()), FileEdges, Directed);
+  Labels = move(FileLabels);
+  return true;
+}
+
+// dijkstra with an indexed heap keyed by distance
+template <typename W>
+pair<vector<typename WeightedCsr<W>::Distance>, vector<VertexId>>
+WeightedCsr<W>::shortestPaths(VertexId Start, true_type) const {
+  pair<vector<Distance>, vector<VertexId>> Paths;
+  if (!validId(Start))
+    return Paths;
+  vector<Distance> &Dist = Paths.first;
+  vector<VertexId> &Prev = Paths.second;
+  Dist.assign(VertexCount, Traits::unreachable());
+  Prev.assign(VertexCount, NO_VERTEX);
+  vector<char> Settled(VertexCount, 0);
+  IndexedHeap<Distance> Queue(VertexCount);
+  Dist[Start] = 0;
+  Queue.push(Start, 0);
+  while (!Queue.empty()) {
+    VertexId Curr = Queue.pop();
+    Settled[Curr] = 1;
+    for (int E = Offsets[Curr]; E < Offsets[Curr + 1]; ++E) {
+      VertexId Next = Targets[E];
+      Distance NewDist = Dist[Curr] + static_cast<Distance>(Weights[E]);
+      if (!Settled[Next] && NewDist < Dist[Next]) {
+        Dist[Next] = NewDist;
+        Prev[Next] = Curr;
+        Queue.pushOrDecrease(Next, NewDist);
+      }
+    }
+  }
+  return Paths;
+}
+
+// every edge has length 1, so vertices are settled in bfs order
+template <typename W>
+pair<vector<typename WeightedCsr<W>::Distance>, vector<VertexId>>
+WeightedCsr<W>::shortestPaths(VertexId Start, false_type) const {
+  pair<vector<Distance>, vector<VertexId>> Paths;
+  if (!validId(Start))
+    return Paths;
+  vector<Distance> &Dist = Paths.first;
+  vector<VertexId> &Prev = Paths.second;
+  Dist.assign(VertexCount, Traits::unreachable());
+  Prev.assign(VertexCount, NO_VERTEX);
+  Dist[Start] = 0;
+  vector<VertexId> Queue(1, Start);
+  for (size_t I = 0; I < Queue.size(); ++I) {
+    VertexId Curr = Queue[I];
+    for (int E = Offsets[Curr]; E < Offsets[Curr + 1]; ++E) {
+      VertexId Next = Targets[E];
+      if (Dist[Next] == Traits::unreachable()) {
+        Dist[Next] = Dist[Curr] + 1;
+        Prev[Next] = Curr;
+        Queue.push_back(Next);
+      }
+    }
+  }
+  return Paths;
+}
+
+// prim, the heap holds the lightest edge into the tree of each vertex
+template <typename W>
+typename WeightedCsr<W>::Distance WeightedCsr<W>::mst(VertexId Start,
+                                                      true_type) const {
+  if (!validId(Start))
+    return -1;
+  vector<char> InTree(VertexCount, 0);
+  IndexedHeap<Distance> Queue(VertexCount);
+  Distance Length = 0;
+  Queue.push(Start, 0);
+  while (!Queue.empty()) {
+    Length += Queue.key(Queue.top());
+    VertexId Curr = Queue.pop();
+    InTree[Curr] = 1;
+    for (int E = Offsets[Curr]; E < Offsets[Curr + 1]; ++E) {
+      if (!InTree[Targets[E]])
+        Queue.pushOrDecrease(Targets[E], static_cast<Distance>(Weights[E]));
+    }
+  }
+  return Length;
+}
+
+template <typename W>
+typename WeightedCsr<W>::Distance WeightedCsr<W>::mst(VertexId Start,
+                                                      false_type) const {
+  if (!validId(Start))
+    return -1;
+  vector<Distance> Dist = shortestPaths(Start, false_type()).first;
+  Distance Reached = 0;
+  for (Distance D : Dist)
+    Reached += D != Traits::unreachable() ? 1 : 0;
+  return Reached - 1;
+}
+
+#endif // WEIGHTEDCSR_H